@@ -96,5 +96,138 @@ float cost_evaluator::operator()(expr * f, unsigned num_args, float const * args
     return eval(f);
 }
 
+bool cost_program::compile(ast_manager & m, expr * f) {
+    arith_util a(m);
+    m_code.reset();
+    if (compile_core(m, a, f))
+        return true;
+    m_code.reset();
+    return false;
+}
 
+bool cost_program::compile_core(ast_manager & m, arith_util & a, expr * f) {
+    if (is_var(f)) {
+        emit(k_arg, to_var(f)->get_idx());
+        return true;
+    }
+    if (!is_app(f))
+        return false;
+    app * n = to_app(f);
+    // operands are compiled as they are used by cost_evaluator.
+    auto args = [&](unsigned k) {
+        if (n->get_num_args() < k)
+            return false;
+        for (unsigned i = 0; i < k; ++i)
+            if (!compile_core(m, a, n->get_arg(i)))
+                return false;
+        return true;
+    };
+    if (n->get_family_id() == m.get_basic_family_id()) {
+        switch (n->get_decl_kind()) {
+        case OP_TRUE:    emit(k_num, 0, 1.0f); return true;
+        case OP_FALSE:   emit(k_num, 0, 0.0f); return true;
+        case OP_NOT:     if (!args(1)) return false; emit(k_not); return true;
+        case OP_AND:     if (!args(n->get_num_args())) return false; emit(k_and, n->get_num_args()); return true;
+        case OP_OR:      if (!args(n->get_num_args())) return false; emit(k_or, n->get_num_args()); return true;
+        case OP_ITE:     if (!args(3)) return false; emit(k_ite); return true;
+        case OP_EQ:      if (!args(2)) return false; emit(k_eq); return true;
+        case OP_XOR:     if (!args(2)) return false; emit(k_xor); return true;
+        case OP_IMPLIES: if (!args(2)) return false; emit(k_implies); return true;
+        default:         return false;
+        }
+    }
+    if (n->get_family_id() == a.get_family_id()) {
+        switch (n->get_decl_kind()) {
+        case OP_NUM: {
+            rational r = n->get_decl()->get_parameter(0).get_rational();
+            emit(k_num, 0, static_cast<float>(numerator(r).get_int64())/static_cast<float>(denominator(r).get_int64()));
+            return true;
+        }
+        case OP_LE:      if (!args(2)) return false; emit(k_le); return true;
+        case OP_GE:      if (!args(2)) return false; emit(k_ge); return true;
+        case OP_LT:      if (!args(2)) return false; emit(k_lt); return true;
+        case OP_GT:      if (!args(2)) return false; emit(k_gt); return true;
+        case OP_ADD:     if (!args(2)) return false; emit(k_add); return true;
+        case OP_SUB:     if (!args(2)) return false; emit(k_sub); return true;
+        case OP_UMINUS:  if (!args(1)) return false; emit(k_uminus); return true;
+        case OP_MUL:     if (!args(2)) return false; emit(k_mul); return true;
+        case OP_DIV:     if (!args(2)) return false; emit(k_div); return true;
+        default:         return false;
+        }
+    }
+    return false;
+}
 
+float cost_program::operator()(unsigned num_args, float const * args) const {
+    SASSERT(!empty());
+    m_stack.reset();
+    for (instr const & i : m_code) {
+        switch (i.m_kind) {
+        case k_num:
+            m_stack.push_back(i.m_val);
+            continue;
+        case k_arg:
+            if (i.m_n < num_args)
+                m_stack.push_back(args[num_args - i.m_n - 1]);
+            else {
+                warning_msg("cost function evaluation error");
+                m_stack.push_back(1.0f);
+            }
+            continue;
+        case k_and:
+        case k_or: {
+            // and: is every operand true, or: is some operand true
+            bool is_and = i.m_kind == k_and;
+            unsigned sz = m_stack.size() - i.m_n;
+            bool r = is_and;
+            for (unsigned j = sz; j < m_stack.size() && r == is_and; ++j)
+                if ((m_stack[j] != 0.0f) != is_and)
+                    r = !is_and;
+            m_stack.shrink(sz);
+            m_stack.push_back(r ? 1.0f : 0.0f);
+            continue;
+        }
+        case k_not: 
+            m_stack.back() = m_stack.back() == 0.0f ? 1.0f : 0.0f; 
+            continue;
+        case k_uminus: 
+            m_stack.back() = -m_stack.back(); 
+            continue;
+        case k_ite: {
+            float e = m_stack.back(); m_stack.pop_back();
+            float t = m_stack.back(); m_stack.pop_back();
+            m_stack.back() = m_stack.back() != 0.0f ? t : e;
+            continue;
+        }
+        default:
+            break;
+        }
+        float y = m_stack.back(); 
+        m_stack.pop_back();
+        float & x = m_stack.back();
+        switch (i.m_kind) {
+        case k_eq:      x = x == y ? 1.0f : 0.0f; break;
+        case k_xor:     x = x != y ? 1.0f : 0.0f; break;
+        case k_implies: x = (x == 0.0f || y != 0.0f) ? 1.0f : 0.0f; break;
+        case k_le:      x = x <= y ? 1.0f : 0.0f; break;
+        case k_ge:      x = x >= y ? 1.0f : 0.0f; break;
+        case k_lt:      x = x <  y ? 1.0f : 0.0f; break;
+        case k_gt:      x = x >  y ? 1.0f : 0.0f; break;
+        case k_add:     x = x + y; break;
+        case k_sub:     x = x - y; break;
+        case k_mul:     x = x * y; break;
+        case k_div:
+            if (y == 0.0f) {
+                warning_msg("cost function division by zero");
+                x = 1.0f;
+            }
+            else 
+                x = x / y;
+            break;
+        default:
+            UNREACHABLE();
+        }
+    }
+    SASSERT(m_stack.size() == 1);
+    return m_stack.back();
+}
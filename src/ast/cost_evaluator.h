@@ -38,4 +38,35 @@ public:
     float operator()(expr * f, unsigned num_args, float const * args);
 };
 
+/**
+   \brief cost function compiled into a postfix program.
+   It produces the same values as cost_evaluator without walking 
+   the cost expression for every evaluation.
+*/
+class cost_program {
+    enum kind {
+        k_num, k_arg, k_not, k_and, k_or, k_ite, k_eq, k_xor, k_implies,
+        k_le, k_ge, k_lt, k_gt, k_add, k_sub, k_uminus, k_mul, k_div
+    };
+    struct instr {
+        kind     m_kind;
+        unsigned m_n;    // arity, or argument index for k_arg
+        float    m_val;  // value for k_num
+    };
+    svector<instr>         m_code;
+    mutable svector<float> m_stack;
+
+    bool compile_core(ast_manager & m, arith_util & a, expr * f);
+    void emit(kind k, unsigned n = 0, float val = 0.0f) { m_code.push_back({ k, n, val }); }
+
+public:
+    /**
+       \brief compile f. Return false if f uses operators that are not supported, 
+       in which case the program is empty.
+    */
+    bool compile(ast_manager & m, expr * f);
+    bool empty() const { return m_code.empty(); }
+    float operator()(unsigned num_args, float const * args) const;
+};
+
 
@@ -112,6 +112,32 @@ namespace dd {
     pdd pdd_manager::mul(rational const& r, pdd const& b) { pdd c(mk_val(r)); return pdd(apply(c.root, b.root, pdd_mul_op), this); }
     pdd pdd_manager::add(rational const& r, pdd const& b) { pdd c(mk_val(r)); return pdd(apply(c.root, b.root, pdd_add_op), this); }
     pdd pdd_manager::zero() { return pdd(zero_pdd, this); }
+
+    pdd pdd_manager::translate(pdd const& p) {
+        SASSERT(p.manager().get_semantics() == m_semantics && p.manager().power_of_2() == m_power_of_2);
+        if (p.m == this)
+            return p;
+        u_map<unsigned> cache;
+        vector<pdd> result;
+        return translate(*p.m, p.root, cache, result);
+    }
+
+    pdd pdd_manager::translate(pdd_manager& src, PDD p, u_map<unsigned>& cache, vector<pdd>& result) {
+        unsigned i;
+        if (cache.find(p, i))
+            return result[i];
+        pdd r = zero();
+        if (src.is_val(p))
+            r = mk_val(src.val(p));
+        else {
+            pdd hi = translate(src, src.hi(p), cache, result);
+            pdd lo = translate(src, src.lo(p), cache, result);
+            r = mk_var(src.var(p)) * hi + lo;
+        }
+        cache.insert(p, result.size());
+        result.push_back(r);
+        return r;
+    }
     pdd pdd_manager::one() { return pdd(one_pdd, this); }
 
     // NOTE: bit-wise AND cannot be expressed in mod2N_e semantics with the existing operations.
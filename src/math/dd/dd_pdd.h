@@ -220,6 +220,7 @@ namespace dd {
         bool is_new_node() const { return m_is_new_node; }
 
         PDD apply(PDD arg1, PDD arg2, pdd_op op);
+        pdd translate(pdd_manager& src, PDD p, u_map<unsigned>& cache, vector<pdd>& result);
         PDD apply_rec(PDD arg1, PDD arg2, pdd_op op);
         PDD minus_rec(PDD p);
         PDD div_rec(PDD p, rational const& c, PDD c_pdd);
@@ -328,12 +329,15 @@ namespace dd {
 
         void reset(unsigned_vector const& level2var);
         void set_max_num_nodes(unsigned n);
+        unsigned max_num_nodes() const { return m_max_num_nodes - m_level2var.size(); }
         unsigned_vector const& get_level2var() const { return m_level2var; }
         unsigned num_nodes() const { return m_nodes.size() - m_free_nodes.size(); }
 
         pdd mk_var(unsigned i);
         pdd mk_val(rational const& r);
         pdd mk_val(unsigned r);
+        // copy p from a manager with the same semantics to this manager
+        pdd translate(pdd const& p);
         pdd zero(); 
         pdd one(); 
         pdd minus(pdd const& a);
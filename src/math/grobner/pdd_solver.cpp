@@ -12,9 +12,13 @@
   --*/
 
 #include "util/uint_set.h"
+#include "util/scoped_ptr_vector.h"
 #include "math/grobner/pdd_solver.h"
 #include "math/grobner/pdd_simplifier.h"
 #include <math.h>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 
 namespace dd {
@@ -95,6 +99,8 @@ namespace dd {
         init_saturate();  
         TRACE("dd.solver", display(tout););
         try {
+            if (m_config.m_threads > 1)
+                saturate_parallel();
             while (!done() && step()) {
                 TRACE("dd.solver", display(tout););
                 DEBUG_CODE(invariant(););
@@ -108,6 +114,136 @@ namespace dd {
         }
     }
 
+    /**
+       A worker of the parallel completion has its own pdd and dependency managers,
+       since they are not thread safe. The polynomials of the equations it starts
+       with are kept in m_seeds, so that the equations it did not change are not
+       copied back.
+    */
+    struct solver::worker {
+        reslimit             m_limit;
+        u_dependency_manager m_dep_manager;
+        pdd_manager          m_manager;
+        solver               m_solver;
+        vector<pdd>          m_seed_polys;
+        u_map<u_dependency*> m_seeds;
+        bool                 m_failed = false;
+
+        worker(pdd_manager& m):
+            m_manager(m.num_vars(), m.get_semantics(), m.power_of_2()),
+            m_solver(m_limit, m_dep_manager, m_manager) {
+            m_manager.reset(m.get_level2var());
+            m_manager.set_max_num_nodes(m.max_num_nodes());
+        }
+    };
+
+    static u_dependency* translate(u_dependency_manager& dst, u_dependency_manager& src, u_dependency* d, unsigned_vector& leaves) {
+        leaves.reset();
+        src.linearize(d, leaves);
+        u_dependency* r = nullptr;
+        for (unsigned v : leaves)
+            r = dst.mk_join(r, dst.mk_leaf(v));
+        return r;
+    }
+
+    /**
+       Parallel completion.
+       The equations to simplify are partitioned among m_threads workers. Each worker
+       starts with a copy of the solved and processed equations and runs the sequential
+       completion on its part. The equations derived or changed by the workers replace
+       the equations to simplify, and the superpositions between the parts are left to
+       the next round or to the sequential completion. The steps and simplifications
+       of a round count as the maximum over the workers, the resource counts of the
+       workers are added to the resource limit of the solver. The equations given to
+       a worker that failed are simplified again.
+    */
+    void solver::saturate_parallel() {
+#ifndef SINGLE_THREAD
+        unsigned num_threads = m_config.m_threads;
+        unsigned_vector leaves;
+        for (unsigned round = 0; round < m_config.m_parallel_rounds; ++round) {
+            if (done() || m_to_simplify.size() < 2 * num_threads)
+                return;
+            scoped_ptr_vector<worker> workers;
+            scoped_limits sl(m_limit);
+            config cfg = m_config;
+            cfg.m_threads = 1;
+            if (cfg.m_max_steps != UINT_MAX)
+                cfg.m_max_steps -= std::min(cfg.m_max_steps, m_stats.m_compute_steps);
+            if (cfg.m_max_simplified != UINT_MAX)
+                cfg.m_max_simplified -= std::min(cfg.m_max_simplified, m_stats.simplified());
+            for (unsigned i = 0; i < num_threads; ++i) {
+                workers.push_back(alloc(worker, m));
+                sl.push_child(&workers[i]->m_limit);
+            }
+            auto copy_to = [&](worker& w, equation const& e, eq_state st) {
+                pdd p = w.m_manager.translate(e.poly());
+                u_dependency* d = translate(w.m_dep_manager, m_dep_manager, e.dep(), leaves);
+                w.m_solver.push_equation(st, alloc(equation, p, d));
+                if (st != to_simplify) {
+                    w.m_seed_polys.push_back(p);
+                    w.m_seeds.insert(p.index(), d);
+                }
+            };
+            for (worker* w : workers) {
+                w->m_solver.set(cfg);
+                for (equation* e : m_solved)
+                    copy_to(*w, *e, solved);
+                for (equation* e : m_processed)
+                    copy_to(*w, *e, processed);
+            }
+            for (unsigned i = 0; i < m_to_simplify.size(); ++i)
+                copy_to(*workers[i % num_threads], *m_to_simplify[i], to_simplify);
+
+            vector<std::thread> threads(num_threads);
+            for (unsigned i = 0; i < num_threads; ++i) {
+                threads[i] = std::thread([&, i]() {
+                    try {
+                        workers[i]->m_solver.saturate();
+                    }
+                    catch (...) {
+                        workers[i]->m_failed = true;
+                    }
+                });
+            }
+            for (auto& th : threads)
+                th.join();
+
+            // merge, the input equations of a worker that failed are kept.
+            unsigned steps = 0, simplified = 0;
+            equation_vector input;
+            input.swap(m_to_simplify);
+            for (unsigned i = 0; i < input.size(); ++i) {
+                if (workers[i % num_threads]->m_failed)
+                    push_equation(to_simplify, input[i]);
+                else
+                    dealloc(input[i]);
+            }
+            for (worker* w : workers) {
+                m_limit.inc(static_cast<unsigned>(std::min<uint64_t>(w->m_limit.count(), UINT_MAX)));
+                stats const& st = w->m_solver.get_stats();
+                steps = std::max(steps, st.m_compute_steps);
+                simplified = std::max(simplified, st.simplified());
+                m_stats.m_superposed += st.m_superposed;
+                if (w->m_failed)
+                    continue;
+                for (equation* e : w->m_solver.equations()) {
+                    u_dependency* d;
+                    if (w->m_seeds.find(e->poly().index(), d) && d == e->dep())
+                        continue;
+                    add(m.translate(e->poly()), translate(m_dep_manager, w->m_dep_manager, e->dep(), leaves));
+                }
+            }
+            m_stats.m_compute_steps += steps;
+            m_stats.add_simplified(simplified);
+            m_levelp1 = m_level2var.size();
+            IF_VERBOSE(3, verbose_stream() << "parallel grobner round " << round << " steps " << steps << "\n");
+            if (steps == 0)
+                return;
+        }
+#endif
+    }
+
     void solver::scoped_process::done() {
         pdd p = e->poly();
         SASSERT(!p.is_val());
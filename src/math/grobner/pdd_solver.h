@@ -45,6 +45,9 @@ public:
         void incr_simplified() {
             m_simplified++;
         }
+        void add_simplified(unsigned n) {
+            m_simplified += n;
+        }
         
     };
 
@@ -60,6 +63,8 @@ public:
         unsigned m_expr_size_growth = 10;
         unsigned m_expr_degree_growth = 5;
         unsigned m_number_of_conflicts_to_report = 1;
+        unsigned m_threads = 1;        // number of threads of the parallel completion
+        unsigned m_parallel_rounds = 2; // number of rounds of the parallel completion
     };
 
     enum eq_state {
@@ -161,7 +166,9 @@ public:
     unsigned number_of_conflicts_to_report() const { return m_config.m_number_of_conflicts_to_report; }
 
 private:
+    struct worker;
     bool step();
+    void saturate_parallel();
     equation* pick_next();
     bool canceled();
     bool done();
@@ -23,6 +23,7 @@ Revision History:
 
 #include "util/vector.h"
 #include "math/lp/implied_bound.h"
+#include "math/lp/row_activity.h"
 #include "math/lp/test_bound_analyzer.h"
 
 namespace lp {
@@ -65,6 +66,16 @@ public :
         return a.analyze();
     }
 
+    // the same as above, for a row of the tableau, but the activity of the row is given
+    // and the row is not scanned to sum the bounds of the monoids.
+    static unsigned analyze_row(const C & row,
+                                const row_activity & act,
+                                unsigned row_index,
+                                B & bp) {
+        bound_analyzer_on_row a(row, null_ci, zero_of_type<numeric_pair<mpq>>(), row_index, bp);
+        return a.analyze(act);
+    }
+
 private:
 
     unsigned analyze() {
@@ -92,6 +103,45 @@ private:
         return num_prop;
     }
 
+    unsigned analyze(const row_activity & act) {
+        if (act.m_max_inf > 1 && act.m_min_inf > 1)
+            return 0;
+        unsigned num_prop = 0;
+        ++num_prop;
+        if (act.m_max_inf == 1) {
+            // the only monoid unlimited from above is at m_max_inf_offset
+            const auto & c = m_row[act.m_max_inf_offset];
+            m_bound = -m_rs.x;
+            m_bound -= act.m_max;
+            m_bound /= c.coeff();
+            bool a_is_pos = is_pos(c.coeff());
+            limit_j(c.var(), m_bound, a_is_pos, a_is_pos, act.m_max_strict > 0);
+        }
+        else if (act.m_max_inf == 0) {
+            m_total = -act.m_max;
+            limit_all_monoids_from_below(act.m_max_strict);
+        }
+        else
+            --num_prop;
+
+        ++num_prop;
+        if (act.m_min_inf == 1) {
+            const auto & c = m_row[act.m_min_inf_offset];
+            m_bound = -m_rs.x;
+            m_bound -= act.m_min;
+            m_bound /= c.coeff();
+            bool a_is_pos = is_pos(c.coeff());
+            limit_j(c.var(), m_bound, a_is_pos, !a_is_pos, act.m_min_strict > 0);
+        }
+        else if (act.m_min_inf == 0) {
+            m_total = -act.m_min;
+            limit_all_monoids_from_above(act.m_min_strict);
+        }
+        else
+            --num_prop;
+        return num_prop;
+    }
+
     bool bound_is_available(unsigned j, bool lower_bound) {
         return (lower_bound && m_bp.lower_bound_is_available(j)) ||
             (!lower_bound && m_bp.upper_bound_is_available(j));
@@ -162,7 +212,11 @@ private:
             if (str)
                 strict++;
         }
-        
+        limit_all_monoids_from_above(strict);
+    }
+
+    // m_total is minus the minimal activity of the row, strict is the number of strict bounds in it
+    void limit_all_monoids_from_above(int strict) {
         for (const auto &p : m_row) {
             bool str;
             bool a_is_pos = is_pos(p.coeff());
@@ -188,7 +242,11 @@ private:
             if (str)
                 strict++;
         }
+        limit_all_monoids_from_below(strict);
+    }
 
+    // m_total is minus the maximal activity of the row, strict is the number of strict bounds in it
+    void limit_all_monoids_from_below(int strict) {
         for (const auto& p : m_row) {
             bool str;
             bool a_is_pos = is_pos(p.coeff());
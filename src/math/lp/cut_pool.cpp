@@ -0,0 +1,143 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cut_pool.cpp
+
+Abstract:
+
+    Pool of cuts for int_solver.
+
+--*/
+
+#include "math/lp/cut_pool.h"
+#include "math/lp/int_solver.h"
+#include "math/lp/lar_solver.h"
+
+namespace lp {
+
+    class cut_pool::pop_trail : public trail {
+        cut_pool& m_pool;
+        unsigned  m_level;
+    public:
+        pop_trail(cut_pool& p, unsigned level): m_pool(p), m_level(level) {}
+        void undo() override { m_pool.pop_level(m_level); }
+    };
+
+    cut_pool::cut_pool(int_solver& lia): lia(lia), lra(lia.lra) {}
+
+    /**
+       \brief set the efficacy of c, the distance of the current solution to the
+       hyperplane of c, and return true if the solution violates c.
+    */
+    bool cut_pool::is_violated(cut& c) const {
+        impq v;
+        double norm = 0;
+        for (lar_term::ival p : c.m_t) {
+            v += p.coeff() * lia.get_value(p.j());
+            double a = p.coeff().get_double();
+            norm += a * a;
+        }
+        c.m_norm = std::sqrt(norm);
+        c.m_efficacy = 0;
+        if (v >= impq(c.m_k))
+            return false;
+        if (c.m_norm > 0)
+            c.m_efficacy = (c.m_k - v.x).get_double() / c.m_norm;
+        return true;
+    }
+
+    double cut_pool::parallelism(cut const& a, cut const& b) const {
+        if (a.m_norm == 0 || b.m_norm == 0)
+            return 0;
+        cut const& s = a.m_t.size() <= b.m_t.size() ? a : b;
+        cut const& l = a.m_t.size() <= b.m_t.size() ? b : a;
+        double dot = 0;
+        mpq c;
+        for (lar_term::ival p : s.m_t)
+            if (l.m_t.coeffs().find(p.j(), c))
+                dot += p.coeff().get_double() * c.get_double();
+        return std::abs(dot) / (a.m_norm * b.m_norm);
+    }
+
+    bool cut_pool::contains(cut const& c) const {
+        mpq d;
+        for (cut const& e : m_cuts) {
+            if (e.m_k != c.m_k || e.m_t.size() != c.m_t.size())
+                continue;
+            if (all_of(c.m_t, [&](lar_term::ival p) { return e.m_t.coeffs().find(p.j(), d) && d == p.coeff(); }))
+                return true;
+        }
+        return false;
+    }
+
+    void cut_pool::insert(cut const& c) {
+        unsigned level = lra.num_scopes();
+        m_cuts.push_back(c);
+        m_cuts.back().m_level = level;
+        m_cuts.back().m_age = 0;
+        // cuts at the base level do not have to be removed
+        if (level > 0)
+            lra.trail().push(pop_trail(*this, level));
+    }
+
+    // the cuts are sorted by level
+    void cut_pool::pop_level(unsigned level) {
+        while (!m_cuts.empty() && m_cuts.back().m_level >= level)
+            m_cuts.pop_back();
+    }
+
+    void cut_pool::select(vector<cut>& candidates, unsigned num_cuts, vector<cut>& result) {
+        auto& s = lia.settings();
+        unsigned nc = candidates.size();
+        auto get_cut = [&](unsigned i) -> cut& { return i < nc ? candidates[i] : m_cuts[i - nc]; };
+        unsigned_vector ranked;
+        for (unsigned i = 0; i < nc; ++i)
+            if (is_violated(candidates[i]))
+                ranked.push_back(i);
+        for (unsigned i = 0; i < m_cuts.size(); ++i) {
+            if (is_violated(m_cuts[i])) {
+                m_cuts[i].m_age = 0;
+                ranked.push_back(nc + i);
+            }
+            else
+                m_cuts[i].m_age++;
+        }
+        std::stable_sort(ranked.begin(), ranked.end(), [&](unsigned i, unsigned j) {
+            return get_cut(i).m_efficacy > get_cut(j).m_efficacy;
+        });
+
+        unsigned_vector selected;
+        for (unsigned i : ranked) {
+            if (selected.size() >= num_cuts)
+                break;
+            if (any_of(selected, [&](unsigned k) { return parallelism(get_cut(i), get_cut(k)) > s.cut_max_parallelism; }))
+                continue;
+            selected.push_back(i);
+        }
+
+        bool_vector is_selected(nc + m_cuts.size(), false);
+        for (unsigned i : selected) {
+            is_selected[i] = true;
+            result.push_back(get_cut(i));
+            if (i >= nc)
+                s.stats().m_cut_pool_cuts++;
+        }
+
+        // remove the selected and old cuts of the pool, it preserves the order by level
+        unsigned j = 0;
+        for (unsigned i = 0; i < m_cuts.size(); ++i) {
+            if (is_selected[nc + i] || m_cuts[i].m_age > s.cut_pool_max_age)
+                continue;
+            if (i != j)
+                m_cuts[j] = std::move(m_cuts[i]);
+            ++j;
+        }
+        m_cuts.shrink(j);
+
+        for (unsigned i = 0; i < nc; ++i)
+            if (!is_selected[i] && m_cuts.size() < s.cut_pool_max_size && !contains(candidates[i]))
+                insert(candidates[i]);
+    }
+}
@@ -0,0 +1,70 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cut_pool.h
+
+Abstract:
+
+    Pool of cuts for int_solver.
+
+    Each round of Gomory cuts generates candidates for several rows.
+    The candidates and the cuts of the pool that are violated by the
+    current solution are ranked by efficacy, the distance of the
+    solution to the cut hyperplane, and a cut is skipped if it is
+    almost parallel to a cut that was already selected.
+    The candidates that are not selected are kept in the pool for the
+    next rounds. A cut is removed from the pool when the scope of
+    lar_solver where it was derived is popped, or when it was not
+    violated for a number of rounds.
+
+--*/
+#pragma once
+
+#include "util/dependency.h"
+#include "math/lp/lar_term.h"
+
+namespace lp {
+    class int_solver;
+    class lar_solver;
+
+    class cut_pool {
+    public:
+        // the cut is m_t >= m_k
+        struct cut {
+            lar_term      m_t;
+            mpq           m_k;
+            u_dependency* m_dep;
+            double        m_norm     = 0;
+            double        m_efficacy = 0;
+            unsigned      m_level    = 0; // number of scopes of lar_solver when the cut was added to the pool
+            unsigned      m_age      = 0; // number of rounds since the cut was added or was violated
+            cut(lar_term const& t, mpq const& k, u_dependency* dep): m_t(t), m_k(k), m_dep(dep) {}
+        };
+
+    private:
+        class pop_trail;
+        int_solver& lia;
+        lar_solver& lra;
+        vector<cut> m_cuts;
+
+        bool is_violated(cut& c) const;
+        double parallelism(cut const& a, cut const& b) const;
+        bool contains(cut const& c) const;
+        void insert(cut const& c);
+        void pop_level(unsigned level);
+
+    public:
+        cut_pool(int_solver& lia);
+
+        /**
+           \brief select up to num_cuts cuts from the candidates and the pool by
+           decreasing efficacy. The selected cuts of the pool are removed from it and
+           the candidates that are not selected are added to it.
+        */
+        void select(vector<cut>& candidates, unsigned num_cuts, vector<cut>& result);
+
+        unsigned size() const { return m_cuts.size(); }
+    };
+}
@@ -0,0 +1,226 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.cpp
+
+Abstract:
+
+    Simplex in double precision used to find a candidate feasible basis
+    for the exact solver of lar_core_solver.
+
+--*/
+
+#include "math/lp/float_simplex.h"
+
+namespace lp {
+
+    void float_simplex::init(lp_core_solver_base<mpq, numeric_pair<mpq>> const & s) {
+        unsigned m = s.m_A.row_count();
+        unsigned n = s.m_A.column_count();
+        m_rows.reset();
+        m_columns.reset();
+        m_rows.resize(m);
+        m_columns.resize(n);
+        for (unsigned i = 0; i < m; ++i) {
+            for (auto const & rc : s.m_A.m_rows[i]) {
+                m_rows[i].push_back({ rc.var(), rc.coeff().get_double() });
+                m_columns[rc.var()].push_back(i);
+            }
+        }
+        m_basis.reset();
+        for (unsigned i = 0; i < m; ++i)
+            m_basis.push_back(s.m_basis[i]);
+        m_heading.reset();
+        m_heading.resize(n, -1);
+        for (unsigned i = 0; i < m; ++i)
+            m_heading[m_basis[i]] = i;
+        m_types.reset();
+        m_lo.reset();
+        m_hi.reset();
+        m_x.reset();
+        for (unsigned j = 0; j < n; ++j) {
+            column_type t = s.m_column_types[j];
+            m_types.push_back(t);
+            m_lo.push_back(t == column_type::lower_bound || t == column_type::boxed || t == column_type::fixed ? to_double(s.m_lower_bounds[j], m_delta) : 0.0);
+            m_hi.push_back(t == column_type::upper_bound || t == column_type::boxed || t == column_type::fixed ? to_double(s.m_upper_bounds[j], m_delta) : 0.0);
+            m_x.push_back(to_double(s.m_x[j], m_delta));
+        }
+        m_moved.reset();
+        m_moved.resize(n, false);
+        m_pos.reset();
+        m_pos.resize(n, -1);
+    }
+
+    bool float_simplex::below_lo(unsigned j) const {
+        switch (m_types[j]) {
+        case column_type::lower_bound:
+        case column_type::boxed:
+        case column_type::fixed:
+            return m_x[j] < m_lo[j] - m_tol * (1 + std::abs(m_lo[j]));
+        default:
+            return false;
+        }
+    }
+
+    bool float_simplex::above_hi(unsigned j) const {
+        switch (m_types[j]) {
+        case column_type::upper_bound:
+        case column_type::boxed:
+        case column_type::fixed:
+            return m_x[j] > m_hi[j] + m_tol * (1 + std::abs(m_hi[j]));
+        default:
+            return false;
+        }
+    }
+
+    bool float_simplex::can_increase(unsigned j) const {
+        switch (m_types[j]) {
+        case column_type::upper_bound:
+        case column_type::boxed:
+            return m_x[j] < m_hi[j] - m_tol * (1 + std::abs(m_hi[j]));
+        case column_type::fixed:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    bool float_simplex::can_decrease(unsigned j) const {
+        switch (m_types[j]) {
+        case column_type::lower_bound:
+        case column_type::boxed:
+            return m_x[j] > m_lo[j] + m_tol * (1 + std::abs(m_lo[j]));
+        case column_type::fixed:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    /**
+       \brief find a non-basic column in row r that can move the basic column of r
+       in the right direction. The basic column b of row r satisfies x_b = - sum a_j x_j.
+       Prefer columns that occur in few rows, as in find_beneficial_entering_tableau_rows,
+       or the column with the smallest index in Bland mode.
+    */
+    int float_simplex::find_entering(unsigned r, bool grow, bool bland) const {
+        unsigned b = m_basis[r];
+        int choice = -1;
+        unsigned best = UINT_MAX;
+        for (cell const & c : m_rows[r]) {
+            unsigned j = c.m_var;
+            if (j == b)
+                continue;
+            // x_b grows if a_j * x_j decreases.
+            bool inc = (c.m_coeff < 0) == grow;
+            if (inc ? !can_increase(j) : !can_decrease(j))
+                continue;
+            unsigned score = bland ? j : m_columns[j].size();
+            if (score < best || (score == best && static_cast<int>(j) < choice)) {
+                best = score;
+                choice = j;
+            }
+        }
+        return choice;
+    }
+
+    bool float_simplex::find_coeff(unsigned i, unsigned j, double & a) const {
+        for (cell const & c : m_rows[i]) {
+            if (c.m_var == j) {
+                a = c.m_coeff;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+       \brief row i += alpha * row r. The coefficient of j in row i becomes 0.
+    */
+    void float_simplex::add_pivot_row(unsigned i, double alpha, unsigned r, unsigned j) {
+        svector<cell> & row = m_rows[i];
+        for (unsigned k = 0; k < row.size(); ++k)
+            m_pos[row[k].m_var] = k;
+        for (cell const & c : m_rows[r]) {
+            int k = m_pos[c.m_var];
+            if (k >= 0)
+                row[k].m_coeff += alpha * c.m_coeff;
+            else {
+                m_pos[c.m_var] = row.size();
+                row.push_back({ c.m_var, alpha * c.m_coeff });
+                m_columns[c.m_var].push_back(i);
+            }
+        }
+        unsigned l = 0;
+        for (unsigned k = 0; k < row.size(); ++k) {
+            cell const & c = row[k];
+            m_pos[c.m_var] = -1;
+            if (c.m_var == j || std::abs(c.m_coeff) < m_zero)
+                continue;
+            row[l++] = c;
+        }
+        row.shrink(l);
+    }
+
+    /**
+       \brief make j the basic column of row r, where a is the coefficient of j in r,
+       and add theta to the value of j.
+    */
+    void float_simplex::pivot(unsigned r, unsigned j, double a, double theta) {
+        unsigned b = m_basis[r];
+        m_x[j] += theta;
+        for (cell & c : m_rows[r])
+            c.m_coeff /= a;
+        for (cell & c : m_rows[r])
+            if (c.m_var == j)
+                c.m_coeff = 1.0;
+        unsigned_vector rows(m_columns[j]);
+        std::sort(rows.begin(), rows.end());
+        rows.shrink(static_cast<unsigned>(std::unique(rows.begin(), rows.end()) - rows.begin()));
+        for (unsigned i : rows) {
+            double aij;
+            if (i == r || !find_coeff(i, j, aij))
+                continue;
+            m_x[m_basis[i]] -= aij * theta;
+            add_pivot_row(i, -aij, r, j);
+        }
+        m_columns[j].reset();
+        m_columns[j].push_back(r);
+        m_basis[r]   = j;
+        m_heading[j] = r;
+        m_heading[b] = -1;
+    }
+
+    bool float_simplex::find_feasible_basis(unsigned max_iterations, lp_settings & settings) {
+        bool bland = false;
+        for (unsigned it = 0; it < max_iterations; ++it) {
+            if (settings.get_cancel_flag())
+                return false;
+            // the infeasible basic column with the smallest index leaves the basis.
+            int leaving = -1;
+            for (unsigned b : m_basis)
+                if (is_infeasible(b) && (leaving == -1 || static_cast<int>(b) < leaving))
+                    leaving = b;
+            if (leaving == -1)
+                return true;
+            // switch to Bland's rule when cycling is likely.
+            if (!bland && it > 10 * m_rows.size() + 100)
+                bland = true;
+            unsigned r = m_heading[leaving];
+            bool grow = below_lo(leaving);
+            int entering = find_entering(r, grow, bland);
+            if (entering == -1)
+                return false;
+            double a;
+            VERIFY(find_coeff(r, entering, a));
+            double target = grow ? m_lo[leaving] : m_hi[leaving];
+            double theta = (m_x[leaving] - target) / a;
+            m_x[leaving] = target;
+            m_moved[leaving] = true;
+            pivot(r, entering, a, theta);
+        }
+        return false;
+    }
+}
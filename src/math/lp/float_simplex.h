@@ -0,0 +1,81 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.h
+
+Abstract:
+
+    Simplex in double precision used to find a candidate feasible basis
+    for the exact solver of lar_core_solver.
+
+    The tableau, the bounds and the values of the exact solver are copied
+    into doubles, and the same row-feasibility loop as in
+    lp_primal_core_solver::one_iteration_tableau_rows is run with
+    tolerances. The result is only a hint: lar_core_solver makes the
+    columns of the basis found here basic in the exact tableau, moves the
+    non-basic columns to the bounds chosen here, and then runs the exact
+    solver, which verifies and repairs the solution.
+
+    The infinitesimal part of strict bounds is replaced by a small constant.
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "math/lp/lp_core_solver_base.h"
+
+namespace lp {
+
+    class float_simplex {
+        struct cell {
+            unsigned m_var;
+            double   m_coeff;
+        };
+        vector<svector<cell>>   m_rows;
+        vector<unsigned_vector> m_columns;   // rows that may contain the column, can have stale entries
+        unsigned_vector         m_basis;     // basic column of each row
+        svector<int>            m_heading;   // row of a basic column, -1 for non-basic columns
+        svector<column_type>    m_types;
+        svector<double>         m_lo, m_hi, m_x;
+        svector<bool>           m_moved;     // non-basic columns whose value changed
+        svector<int>            m_pos;       // position of a column in the row being updated, -1 if none
+        double                  m_tol   = 1e-9;  // feasibility tolerance
+        double                  m_zero  = 1e-12; // coefficients below it are dropped
+        double                  m_delta = 1e-6;  // value of the infinitesimal in strict bounds
+
+        static double to_double(numeric_pair<mpq> const & v, double delta) {
+            return v.x.get_double() + delta * v.y.get_double();
+        }
+
+        bool below_lo(unsigned j) const;
+        bool above_hi(unsigned j) const;
+        bool is_infeasible(unsigned j) const { return below_lo(j) || above_hi(j); }
+        bool can_increase(unsigned j) const;
+        bool can_decrease(unsigned j) const;
+        int  find_entering(unsigned r, bool grow, bool bland) const;
+        bool find_coeff(unsigned i, unsigned j, double & a) const;
+        void add_pivot_row(unsigned i, double alpha, unsigned r, unsigned j);
+        void pivot(unsigned r, unsigned j, double a, double theta);
+
+    public:
+        /**
+           \brief copy the tableau, bounds and values of s.
+        */
+        void init(lp_core_solver_base<mpq, numeric_pair<mpq>> const & s);
+
+        /**
+           \brief run the row-feasibility loop. Return true if a basis where all
+           basic columns are within their bounds (up to tolerance) was found within
+           max_iterations iterations.
+        */
+        bool find_feasible_basis(unsigned max_iterations, lp_settings & settings);
+
+        bool is_basic(unsigned j) const { return m_heading[j] >= 0; }
+
+        bool moved(unsigned j) const { return m_moved[j]; }
+
+        double get_value(unsigned j) const { return m_x[j]; }
+    };
+}
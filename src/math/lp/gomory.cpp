@@ -328,8 +328,6 @@ public:
         TRACE("gomory_cut_detail", dump_cut_and_constraints_as_smt_lemma(tout);
               lia.lra.display(tout));
         SASSERT(lia.current_solution_is_inf_on_cut());
-              
-        lia.settings().stats().m_gomory_cuts++;
         return lia_move::cut;
     }
 
@@ -482,7 +480,8 @@ public:
     lia_move gomory::get_gomory_cuts(unsigned num_cuts) {
         struct cut_result {lar_term t; mpq k; u_dependency *dep;};
         vector<cut_result> big_cuts;
-        unsigned_vector columns_for_cuts = gomory_select_int_infeasible_vars(num_cuts);
+        vector<cut_pool::cut> candidates, cuts;
+        unsigned_vector columns_for_cuts = gomory_select_int_infeasible_vars(std::max(num_cuts, lia.settings().gomory_cut_candidates));
         bool has_small_cut = false;
 
         // define inline helper functions
@@ -519,13 +518,18 @@ public:
                 lra.update_column_type_and_bound(j, lp::lconstraint_kind::LE, floor(lra.get_column_value(j).x), add_deps(cc.m_dep, row, j));
             else if (cc.m_polarity == row_polarity::MIN)
                 lra.update_column_type_and_bound(j, lp::lconstraint_kind::GE, ceil(lra.get_column_value(j).x), add_deps(cc.m_dep, row, j));
-            
-            if (!is_small_cut(lia.m_t)) {
-                big_cuts.push_back({cc.m_t, cc.m_k, cc.m_dep});
+            candidates.push_back(cut_pool::cut(cc.m_t, cc.m_k, cc.m_dep));
+        }
+
+        lia.m_cut_pool.select(candidates, num_cuts, cuts);
+        for (auto const& c : cuts) {
+            lia.settings().stats().m_gomory_cuts++;
+            if (!is_small_cut(c.m_t)) {
+                big_cuts.push_back({c.m_t, c.m_k, c.m_dep});
                 continue;
             }
             has_small_cut = true;
-            add_cut(cc.m_t, cc.m_k, cc.m_dep);
+            add_cut(c.m_t, c.m_k, c.m_dep);
             if (lia.settings().get_cancel_flag())
                 return lia_move::undef;
         }
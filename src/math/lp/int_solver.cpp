@@ -152,7 +152,8 @@ namespace lp {
         m_patcher(*this),
         m_number_of_calls(0),
         m_hnf_cutter(*this),
-        m_hnf_cut_period(settings().hnf_cut_period()) {
+        m_hnf_cut_period(settings().hnf_cut_period()),
+        m_cut_pool(*this) {
         lra.set_int_solver(this);
     }
 
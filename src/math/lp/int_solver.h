@@ -24,6 +24,7 @@ Revision History:
 #include "math/lp/lar_term.h"
 #include "math/lp/lar_constraints.h"
 #include "math/lp/hnf_cutter.h"
+#include "math/lp/cut_pool.h"
 #include "math/lp/int_gcd_test.h"
 #include "math/lp/lia_move.h"
 #include "math/lp/explanation.h"
@@ -39,6 +40,7 @@ class int_solver {
     friend class int_branch;
     friend class int_gcd_test;
     friend class hnf_cutter;
+    friend class cut_pool;
 
     class patcher {
         int_solver&         lia;
@@ -68,6 +70,7 @@ class int_solver {
     hnf_cutter          m_hnf_cutter;
     unsigned            m_hnf_cut_period;
     unsigned_vector     m_cut_vars;        // variables that should not be selected for cuts
+    cut_pool            m_cut_pool;
     
     vector<equality>       m_equalities;
 public:
@@ -90,6 +90,9 @@ public:
 
     void solve();
 
+    void find_basis_with_doubles();
+    void move_non_basic_column(unsigned j, numeric_pair<mpq> const & v);
+
     void pivot(int entering, int leaving) { m_r_solver.pivot(entering, leaving); }
     
     bool lower_bounds_are_set() const { return true; }
@@ -14,6 +14,7 @@ Revision History:
 #include <string>
 #include "util/vector.h"
 #include "math/lp/lar_core_solver.h"
+#include "math/lp/float_simplex.h"
 namespace lp {
 lar_core_solver::lar_core_solver(
     lp_settings & settings,
@@ -82,6 +83,75 @@ unsigned lar_core_solver::get_number_of_non_ints() const {
     return n;
 }
 
+void lar_core_solver::move_non_basic_column(unsigned j, numeric_pair<mpq> const & v) {
+    lp_assert(!m_r_solver.column_is_base(j));
+    numeric_pair<mpq> delta = v - m_r_x[j];
+    if (is_zero(delta))
+        return;
+    m_r_solver.add_delta_to_x(j, delta);
+    for (const auto & c : m_r_A.m_columns[j])
+        m_r_solver.add_delta_to_x_and_track_feasibility(m_r_basis[c.var()], -delta * m_r_A.get_val(c));
+}
+
+/**
+   \brief Use the simplex in doubles to find a candidate feasible basis, and install it:
+   the columns of the candidate basis become basic by exact pivoting and the non-basic
+   columns moved by the double simplex go to the closest bound. The exact simplex that
+   runs afterwards repairs the solution if the candidate is not feasible in rationals.
+*/
+void lar_core_solver::find_basis_with_doubles() {
+    ++m_r_solver.m_settings.stats().m_float_simplex_calls;
+    float_simplex fs;
+    fs.init(m_r_solver);
+    if (!fs.find_feasible_basis(10 * m_r_A.row_count() + 1000, m_r_solver.m_settings))
+        return;
+    ++m_r_solver.m_settings.stats().m_float_simplex_bases;
+    unsigned_vector entering;
+    for (unsigned j : m_r_nbasis)
+        if (fs.is_basic(j))
+            entering.push_back(j);
+    unsigned_vector leaving;
+    for (unsigned j : entering) {
+        int row = -1;
+        for (const auto & c : m_r_A.m_columns[j]) {
+            if (!fs.is_basic(m_r_basis[c.var()])) {
+                row = c.var();
+                break;
+            }
+        }
+        if (row == -1)
+            continue;
+        unsigned bj = m_r_basis[row];
+        m_r_solver.pivot(j, bj);
+        leaving.push_back(bj);
+    }
+    for (unsigned j : m_r_nbasis) {
+        if (!fs.moved(j) && m_r_solver.column_is_feasible(j))
+            continue;
+        double v = fs.get_value(j);
+        switch (m_column_types[j]) {
+        case column_type::fixed:
+        case column_type::lower_bound:
+            move_non_basic_column(j, m_r_solver.m_lower_bounds[j]);
+            break;
+        case column_type::upper_bound:
+            move_non_basic_column(j, m_r_solver.m_upper_bounds[j]);
+            break;
+        case column_type::boxed:
+            if (std::abs(v - m_r_solver.m_lower_bounds[j].x.get_double()) <= std::abs(v - m_r_solver.m_upper_bounds[j].x.get_double()))
+                move_non_basic_column(j, m_r_solver.m_lower_bounds[j]);
+            else
+                move_non_basic_column(j, m_r_solver.m_upper_bounds[j]);
+            break;
+        default:
+            break;
+        }
+    }
+    for (unsigned j : leaving)
+        m_r_solver.remove_column_from_inf_heap(j);
+    TRACE("lar_solver", tout << "float simplex basis, entering: " << entering.size() << " leaving: " << leaving.size() << "\n";);
+}
+
 void lar_core_solver::solve() {
     TRACE("lar_solver", tout << m_r_solver.get_status() << "\n";);
     lp_assert(m_r_solver.non_basic_columns_are_set_correctly());
@@ -95,8 +165,11 @@ void lar_core_solver::solve() {
     ++m_r_solver.m_settings.stats().m_need_to_solve_inf;
     lp_assert( r_basis_is_OK());
              
-    if (m_r_solver.m_look_for_feasible_solution_only) //todo : should it be set?
-         m_r_solver.find_feasible_solution();
+    if (m_r_solver.m_look_for_feasible_solution_only) { //todo : should it be set?
+        if (settings().float_simplex() && m_r_solver.inf_heap_size() >= settings().float_simplex_min_infeasible)
+            find_basis_with_doubles();
+        m_r_solver.find_feasible_solution();
+    }
     else 
         m_r_solver.solve();
     
@@ -24,7 +24,9 @@ namespace lp {
     lar_solver::lar_solver() :
         m_mpq_lar_core_solver(m_settings, *this),
         m_var_register(),
-        m_constraints(m_dependencies, *this) {}
+        m_constraints(m_dependencies, *this) {
+        m_mpq_lar_core_solver.m_r_solver.m_changed_rows = &m_activity_rows;
+    }
 
     // start or ends tracking the rows that were changed by solve()
     void lar_solver::track_touched_rows(bool v) {
@@ -131,13 +133,6 @@ namespace lp {
     }
 
 
-    bool lar_solver::row_has_a_big_num(unsigned i) const {
-        for (const auto& c : A_r().m_rows[i]) 
-            if (c.coeff().is_big())
-                return true;
-        return false;
-    }
-
     lp_status lar_solver::get_status() const { return m_status; }
 
     void lar_solver::set_status(lp_status s) {
@@ -235,6 +230,12 @@ namespace lp {
 
         unsigned m = A_r().row_count();
         clean_popped_elements(m, m_touched_rows);
+        clean_popped_elements(m, m_activity_rows);
+        clean_popped_elements(n, m_activity_columns);
+        if (m_row_activities.size() > m)
+            m_row_activities.shrink(m);
+        if (m_activity_bounds.size() > n)
+            m_activity_bounds.shrink(n);
         clean_inf_heap_of_r_solver_after_pop();
         SASSERT(m_mpq_lar_core_solver.m_r_solver.reduced_costs_are_correct_tableau());
 
@@ -1201,10 +1202,127 @@ namespace lp {
             add_touched_row(r.var());        
     }
 
+    /**
+       \brief move the touched rows that fit into the work limit of one round of
+       bound propagation to m_bprop_rows. The work of a row is its length, rows
+       that are too long for bound propagation are skipped at no cost.
+       The remaining rows stay touched and are analyzed in the next round.
+    */
+    void lar_solver::select_touched_rows_for_bprop() {
+        m_bprop_rows.reset();
+        unsigned max_work = settings().bprop_max_work();
+        unsigned work = 0;
+        for (unsigned i : m_touched_rows) {
+            if (max_work > 0 && work >= max_work)
+                break;
+            unsigned sz = A_r().m_rows[i].size();
+            if (sz <= settings().max_row_length_for_bound_propagation)
+                work += sz;
+            m_bprop_rows.push_back(i);
+        }
+        if (m_bprop_rows.size() == m_touched_rows.size())
+            m_touched_rows.reset();
+        else 
+            for (unsigned i : m_bprop_rows)
+                m_touched_rows.remove(i);
+        stats().m_bprop_rows += m_bprop_rows.size();
+        stats().m_bprop_deferred_rows += m_touched_rows.size();
+    }
+
     void lar_solver::pop() {
         pop(1);
     }
 
+    // the activities of rows with changed coefficients are computed again,
+    // the activities of the other rows are updated by the changed bounds of their columns
+    void lar_solver::update_row_activities() {
+        for (unsigned i : m_activity_rows)
+            if (i < m_row_activities.size())
+                m_row_activities[i].m_valid = false;
+        m_activity_rows.reset();
+        for (unsigned j : m_activity_columns) {
+            if (j >= m_activity_bounds.size() || !m_activity_bounds[j].m_valid)
+                continue;
+            auto& b = m_activity_bounds[j];
+            column_type t = get_column_type(j);
+            const impq& lo = get_lower_bound(j);
+            const impq& hi = get_upper_bound(j);
+            for (const auto& c : A_r().m_columns[j]) {
+                if (c.var() >= m_row_activities.size())
+                    continue;
+                row_activity& act = m_row_activities[c.var()];
+                if (!act.m_valid)
+                    continue;
+                const mpq& a = A_r().get_val(c);
+                act.update(false, a, c.offset(), b.m_type, b.m_lower, b.m_upper);
+                act.update(true, a, c.offset(), t, lo, hi);
+            }
+            b.m_type = t;
+            b.m_lower = lo;
+            b.m_upper = hi;
+        }
+        m_activity_columns.reset();
+    }
+
+    void lar_solver::compute_row_activity(unsigned i, row_activity& act) {
+        act.reset();
+        unsigned k = 0;
+        for (const auto& c : A_r().m_rows[i]) {
+            unsigned j = c.var();
+            auto& b = m_activity_bounds[j];
+            if (!b.m_valid) {
+                b.m_type = get_column_type(j);
+                b.m_lower = get_lower_bound(j);
+                b.m_upper = get_upper_bound(j);
+                b.m_valid = true;
+            }
+            if (c.coeff().is_big())
+                act.m_has_big_num = true;
+            act.update(true, c.coeff(), k++, b.m_type, b.m_lower, b.m_upper);
+        }
+    }
+
+    const row_activity& lar_solver::get_row_activity(unsigned i) {
+        if (!m_activity_rows.empty() || !m_activity_columns.empty())
+            update_row_activities();
+        if (m_row_activities.size() < A_r().row_count())
+            m_row_activities.resize(A_r().row_count());
+        if (m_activity_bounds.size() < A_r().column_count())
+            m_activity_bounds.resize(A_r().column_count());
+        row_activity& act = m_row_activities[i];
+        if (!act.m_valid) {
+            compute_row_activity(i, act);
+            act.m_valid = true;
+        }
+        return act;
+    }
+
+    bool lar_solver::row_activities_are_correct() {
+        update_row_activities();
+        for (unsigned i = 0; i < m_row_activities.size(); ++i) {
+            const row_activity& act = m_row_activities[i];
+            if (!act.m_valid)
+                continue;
+            row_activity r;
+            unsigned k = 0;
+            for (const auto& c : A_r().m_rows[i]) {
+                unsigned j = c.var();
+                if (c.coeff().is_big())
+                    r.m_has_big_num = true;
+                r.update(true, c.coeff(), k++, get_column_type(j), get_lower_bound(j), get_upper_bound(j));
+            }
+            if (act.m_min != r.m_min || act.m_max != r.m_max ||
+                act.m_min_inf != r.m_min_inf || act.m_max_inf != r.m_max_inf ||
+                act.m_min_inf_offset != r.m_min_inf_offset || act.m_max_inf_offset != r.m_max_inf_offset ||
+                act.m_min_strict != r.m_min_strict || act.m_max_strict != r.m_max_strict ||
+                act.m_has_big_num != r.m_has_big_num) {
+                TRACE("lar_solver", tout << "incorrect activity of row " << i << "\n";);
+                return false;
+            }
+        }
+        return true;
+    }
+
     bool lar_solver::column_represents_row_in_tableau(unsigned j) {
         return m_columns[j].associated_with_row();
     }
@@ -1818,8 +1936,20 @@ namespace lp {
         TRACE("lar_solver_feas", tout << "j = " << j << " became " << (this->column_is_feasible(j) ? "feas" : "non-feas") << ", and " << (this->column_is_bounded(j) ? "bounded" : "non-bounded") << std::endl;);
     }
 
+    // the bounds of j are restored on pop, so the row activities are updated again
+    struct lar_solver::undo_activity_bounds : public trail {
+        lar_solver& s;
+        unsigned j;
+        undo_activity_bounds(lar_solver& s, unsigned j) : s(s), j(j) {}
+        void undo() override {
+            s.m_activity_columns.insert(j);
+        }
+    };
+
     void lar_solver::insert_to_columns_with_changed_bounds(unsigned j) {
         m_columns_with_changed_bounds.insert(j);
+        m_activity_columns.insert(j);
+        m_trail.push(undo_activity_bounds(*this, j));
         TRACE("lar_solver", tout << "column " << j << (column_is_feasible(j) ? " feas" : " non-feas") << "\n";);
     }
 
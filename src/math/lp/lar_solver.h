@@ -37,6 +37,7 @@
 #include "math/lp/nra_solver.h"
 #include "math/lp/numeric_pair.h"
 #include "math/lp/random_updater.h"
+#include "math/lp/row_activity.h"
 #include "math/lp/stacked_vector.h"
 #include "util/buffer.h"
 #include "util/debug.h"
@@ -91,7 +92,21 @@ class lar_solver : public column_namer {
     // the set of column indices j such that bounds have changed for j
     indexed_uint_set m_columns_with_changed_bounds;
     indexed_uint_set m_touched_rows;
+    // the touched rows analyzed in the current round of bound propagation
+    unsigned_vector m_bprop_rows;
     unsigned_vector m_row_bounds_to_replay;
+    // the activities of the rows for bound propagation, they are computed on demand
+    vector<row_activity> m_row_activities;
+    // the bounds of the columns as they are summed in m_row_activities
+    struct activity_bounds {
+        column_type m_type = column_type::free_column;
+        impq        m_lower, m_upper;
+        bool        m_valid = false;
+    };
+    vector<activity_bounds> m_activity_bounds;
+    // the columns with bounds changed, and the rows with coefficients changed, since m_row_activities were updated
+    indexed_uint_set m_activity_columns;
+    indexed_uint_set m_activity_rows;
     u_dependency_manager m_dependencies;
     svector<constraint_index> m_tmp_dependencies;
 
@@ -118,11 +133,11 @@ class lar_solver : public column_namer {
 
     ////////////////// nested structs /////////////////////////
     struct undo_add_column;
+    struct undo_activity_bounds;
 
     ////////////////// methods ////////////////////////////////
 
     static bool valid_index(unsigned j) { return static_cast<int>(j) >= 0; }
-    bool row_has_a_big_num(unsigned i) const;
     // init region
     void register_new_external_var(unsigned ext_v, bool is_int);
     bool term_is_int(const lar_term* t) const;
@@ -179,16 +194,20 @@ class lar_solver : public column_namer {
 
     template <typename T>
     unsigned calculate_implied_bounds_for_row(unsigned row_index, lp_bound_propagator<T>& bp) {
-        if (A_r().m_rows[row_index].size() > settings().max_row_length_for_bound_propagation || row_has_a_big_num(row_index))
+        if (A_r().m_rows[row_index].size() > settings().max_row_length_for_bound_propagation)
+            return 0;
+        const row_activity& act = get_row_activity(row_index);
+        if (act.m_has_big_num)
             return 0;
 
         return bound_analyzer_on_row<row_strip<mpq>, lp_bound_propagator<T>>::analyze_row(
             A_r().m_rows[row_index],
-            null_ci,
-            zero_of_type<numeric_pair<mpq>>(),
+            act,
             row_index,
             bp);
     }
+    void update_row_activities();
+    void compute_row_activity(unsigned i, row_activity& act);
 
     static void clean_popped_elements_for_heap(unsigned n, lpvar_heap& set);
     static void clean_popped_elements(unsigned n, indexed_uint_set& set);
@@ -358,13 +377,17 @@ public:
     void activate(constraint_index);
     void random_update(unsigned sz, lpvar const* vars);
     void add_column_rows_to_touched_rows(lpvar j);
+    void select_touched_rows_for_bprop();
     template <typename T>
     void propagate_bounds_for_touched_rows(lp_bound_propagator<T>& bp) {
         if (settings().propagate_eqs()) {
             if (settings().random_next() % 10 == 0) 
                 remove_fixed_vars_from_base();
+        }
+        select_touched_rows_for_bprop();
+        if (settings().propagate_eqs()) {
             bp.clear_for_eq();
-            for (unsigned i : m_touched_rows) {
+            for (unsigned i : m_bprop_rows) {
                 unsigned offset_eqs = stats().m_offset_eqs;
                 bp.cheap_eq_on_nbase(i);
                 if (settings().get_cancel_flag())
@@ -373,12 +396,11 @@ public:
                     m_row_bounds_to_replay.push_back(i);
             }
         }
-        for (unsigned i : m_touched_rows) {
+        for (unsigned i : m_bprop_rows) {
             calculate_implied_bounds_for_row(i, bp);
             if (settings().get_cancel_flag())
                 return;
         }
-        m_touched_rows.reset();
     }
     void collect_more_rows_for_lp_propagation();
     template <typename T>
@@ -632,6 +654,9 @@ public:
     }
     void round_to_integer_solution();
     inline const row_strip<mpq>& get_row(unsigned i) const { return A_r().m_rows[i]; }
+    // the activity of the row under the current bounds, it is updated incrementally
+    const row_activity& get_row_activity(unsigned i);
+    bool row_activities_are_correct();
     inline const row_strip<mpq>& basic2row(unsigned i) const { return A_r().m_rows[row_of_basic_column(i)]; }
     inline const column_strip& get_column(unsigned i) const { return A_r().m_columns[i]; }
     bool row_is_correct(unsigned i) const;
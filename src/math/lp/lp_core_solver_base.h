@@ -94,6 +94,8 @@ public:
     bool                  m_tracing_basis_changes;
     // these rows are changed by adding to them a multiple of the pivot row
     indexed_uint_set*     m_touched_rows = nullptr;
+    // rows whose coefficients are changed by pivoting or transposing, it is not reset by the solver
+    indexed_uint_set*     m_changed_rows = nullptr;
     bool                  m_look_for_feasible_solution_only;
 
     void start_tracing_basis_changes() {
@@ -255,6 +255,8 @@ template <typename T, typename X> bool lp_core_solver_base<T, X>::
 pivot_column_tableau(unsigned j, unsigned piv_row_index) {
 	if (!divide_row_by_pivot(piv_row_index, j))
         return false;
+    if (m_changed_rows != nullptr)
+        m_changed_rows->insert(piv_row_index);
     auto &column = m_A.m_columns[j];
     int pivot_col_cell_index = -1;
     for (unsigned k = 0; k < column.size(); k++) {
@@ -279,11 +281,14 @@ pivot_column_tableau(unsigned j, unsigned piv_row_index) {
     while (column.size() > 1) {
         auto & c = column.back();
         lp_assert(c.var() != piv_row_index);
+        unsigned row_index = c.var();
+        if (m_changed_rows != nullptr)
+            m_changed_rows->insert(row_index);
         if(! m_A.pivot_row_to_row_given_cell(piv_row_index, c, j)) {
             return false;
         }
         if (m_touched_rows!= nullptr)
-            m_touched_rows->insert(c.var());
+            m_touched_rows->insert(row_index);
     }
 
     if (m_settings.simplex_strategy() == simplex_strategy_enum::tableau_costs)
@@ -388,6 +393,10 @@ column_name(unsigned column) const {
 template <typename T, typename X>  void lp_core_solver_base<T, X>::transpose_rows_tableau(unsigned i, unsigned j) {
     transpose_basis(i, j);
     m_A.transpose_rows(i, j);
+    if (m_changed_rows != nullptr) {
+        m_changed_rows->insert(i);
+        m_changed_rows->insert(j);
+    }
 }
 // entering is the new base column, leaving - the column leaving the basis
 template <typename T, typename X> bool lp_core_solver_base<T, X>::pivot_column_general(unsigned entering, unsigned leaving, indexed_vector<T> & w) {
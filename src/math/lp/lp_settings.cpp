@@ -31,5 +31,7 @@ void lp::lp_settings::updt_params(params_ref const& _p) {
     m_print_external_var_name = p.arith_print_ext_var_names();
     report_frequency = p.arith_rep_freq();
     m_simplex_strategy = static_cast<lp::simplex_strategy_enum>(p.arith_simplex_strategy());
+    m_float_simplex = p.arith_float_simplex();
+    m_bprop_max_work = p.arith_bprop_max_work();
     m_nlsat_delay = p.arith_nl_delay();
 }
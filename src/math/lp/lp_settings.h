@@ -128,6 +128,11 @@ struct statistics {
     unsigned m_grobner_conflicts;
     unsigned m_offset_eqs;
     unsigned m_fixed_eqs;
+    unsigned m_float_simplex_calls;
+    unsigned m_float_simplex_bases;
+    unsigned m_bprop_rows;
+    unsigned m_bprop_deferred_rows;
+    unsigned m_cut_pool_cuts;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
@@ -144,6 +149,7 @@ struct statistics {
         st.update("arith-hnf-calls", m_hnf_cutter_calls);
         st.update("arith-hnf-cuts", m_hnf_cuts);
         st.update("arith-gomory-cuts", m_gomory_cuts);
+        st.update("arith-cut-pool-cuts", m_cut_pool_cuts);
         st.update("arith-horner-calls", m_horner_calls);
         st.update("arith-horner-conflicts", m_horner_conflicts);
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
@@ -157,6 +163,10 @@ struct statistics {
         st.update("arith-nla-lemmas", m_nla_lemmas);
         st.update("arith-nra-calls", m_nra_calls);   
         st.update("arith-bounds-improvements", m_nla_bounds_improvements);
+        st.update("arith-float-simplex-calls", m_float_simplex_calls);
+        st.update("arith-float-simplex-bases", m_float_simplex_bases);
+        st.update("arith-bprop-rows", m_bprop_rows);
+        st.update("arith-bprop-deferred-rows", m_bprop_deferred_rows);
 
     }
 };
@@ -214,6 +224,13 @@ public:
     unsigned         column_number_threshold_for_using_lu_in_lar_solver = 4000;
     unsigned         m_int_gomory_cut_period = 4;
     unsigned         m_int_find_cube_period = 4;
+    // the double precision simplex runs when at least this number of columns is infeasible
+    unsigned         float_simplex_min_infeasible = 64;
+    // number of rows for which Gomory cuts are generated in one round, see cut_pool
+    unsigned         gomory_cut_candidates = 8;
+    double           cut_max_parallelism = 0.9;
+    unsigned         cut_pool_max_age = 8;
+    unsigned         cut_pool_max_size = 256;
 private:
     unsigned         m_hnf_cut_period = 4;
     bool             m_int_run_gcd_test = true;
@@ -225,7 +242,12 @@ private:
     bool             m_enable_hnf = true;
     bool             m_print_external_var_name = false;
     bool             m_propagate_eqs = false;
+    bool             m_float_simplex = false;
+    unsigned         m_bprop_max_work = 0;
 public:
+    bool float_simplex() const { return m_float_simplex; }
+    void set_float_simplex(bool f) { m_float_simplex = f; }
+    unsigned bprop_max_work() const { return m_bprop_max_work; }
     bool print_external_var_name() const { return m_print_external_var_name; }
     bool propagate_eqs() const { return m_propagate_eqs;}
     unsigned hnf_cut_period() const { return m_hnf_cut_period; }
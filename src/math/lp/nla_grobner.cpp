@@ -269,6 +269,7 @@ namespace nla {
         cfg.m_expr_size_growth = c().params().arith_nl_grobner_expr_size_growth();
         cfg.m_expr_degree_growth = c().params().arith_nl_grobner_expr_degree_growth();
         cfg.m_number_of_conflicts_to_report = c().params().arith_nl_grobner_cnfl_to_report();
+        cfg.m_threads = c().params().arith_nl_grobner_threads();
         m_solver.set(cfg);
         m_solver.adjust_cfg();
         m_pdd_manager.set_max_num_nodes(10000); // or something proportional to the number of initial nodes.
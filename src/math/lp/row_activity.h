@@ -0,0 +1,82 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    row_activity.h
+
+Abstract:
+
+    Activity bounds of a tableau row sum_j a_j*x_j = 0 for bound propagation.
+
+    The minimal (maximal) activity of the row is the sum of the minimal
+    (maximal) values of the monoids a_j*x_j under the bounds of x_j. Monoids
+    without a finite minimum (maximum) are counted instead of summed, and
+    the sum of their offsets in the row identifies the monoid when there is
+    only one. The number of summed bounds that are strict is also kept.
+
+    Adding or removing a monoid is O(1), so lar_solver updates the activities
+    when a column bound changes instead of scanning the rows again.
+
+--*/
+#pragma once
+
+#include "math/lp/lp_settings.h"
+#include "math/lp/numeric_pair.h"
+
+namespace lp {
+
+    struct row_activity {
+        mpq      m_min, m_max;                                // sums of the finite minima and maxima of the monoids
+        unsigned m_min_inf = 0, m_max_inf = 0;                // number of monoids without a finite minimum and maximum
+        unsigned m_min_inf_offset = 0, m_max_inf_offset = 0;  // sum of the offsets in the row of these monoids
+        unsigned m_min_strict = 0, m_max_strict = 0;          // number of strict bounds in m_min and m_max
+        bool     m_has_big_num = false;                       // the row has a big coefficient
+        bool     m_valid = false;
+
+        void reset() {
+            m_min.reset();
+            m_max.reset();
+            m_min_inf = m_max_inf = 0;
+            m_min_inf_offset = m_max_inf_offset = 0;
+            m_min_strict = m_max_strict = 0;
+            m_has_big_num = false;
+        }
+
+        /**
+           \brief add (add = true) or remove the monoid a*x at the offset in the row,
+           where x has the type t and the bounds lo and hi.
+        */
+        void update(bool add, mpq const& a, unsigned offset, column_type t, impq const& lo, impq const& hi) {
+            bool has_lo = t == column_type::lower_bound || t == column_type::boxed || t == column_type::fixed;
+            bool has_hi = t == column_type::upper_bound || t == column_type::boxed || t == column_type::fixed;
+            bool a_is_pos = is_pos(a);
+            update(add, a, offset, a_is_pos ? has_lo : has_hi, a_is_pos ? lo : hi, m_min, m_min_inf, m_min_inf_offset, m_min_strict);
+            update(add, a, offset, a_is_pos ? has_hi : has_lo, a_is_pos ? hi : lo, m_max, m_max_inf, m_max_inf_offset, m_max_strict);
+        }
+
+    private:
+        static void update(bool add, mpq const& a, unsigned offset, bool has_bound, impq const& b,
+                           mpq& sum, unsigned& num_inf, unsigned& inf_offset, unsigned& num_strict) {
+            if (!has_bound) {
+                if (add) {
+                    ++num_inf;
+                    inf_offset += offset;
+                }
+                else {
+                    --num_inf;
+                    inf_offset -= offset;
+                }
+            }
+            else if (add) {
+                sum.addmul(a, b.x);
+                num_strict += !is_zero(b.y);
+            }
+            else {
+                sum.submul(a, b.x);
+                num_strict -= !is_zero(b.y);
+            }
+        }
+    };
+
+}
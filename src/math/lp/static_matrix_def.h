@@ -26,8 +26,38 @@ Revision History:
 namespace lp {
 // each assignment for this matrix should be issued only once!!!
 
+// Most coefficients of the tableau are small integers, which mpq keeps
+// inline. For them the row operations are done in int64 instead of going
+// through mpq_manager; a result that does not fit in an int is promoted
+// by the assignment.
+inline bool is_small_int(mpq const& a) { return a.is_small() && a.is_int(); }
+inline int64_t small_int_value(mpq const& a) { return a.to_mpq().numerator().value(); }
+
+inline void set_int64(mpq& r, int64_t v) {
+    if (INT_MIN <= v && v <= INT_MAX)
+        r = static_cast<int>(v);
+    else
+        r = mpq(v, mpq::i64());
+}
+
 inline void addmul(double& r, double a, double b) { r += a*b; }
-inline void addmul(mpq& r, mpq const& a, mpq const& b) { r.addmul(a, b); }
+inline void addmul(mpq& r, mpq const& a, mpq const& b) {
+    // the product of two ints and an int fit in int64
+    if (is_small_int(r) && is_small_int(a) && is_small_int(b))
+        set_int64(r, small_int_value(r) + small_int_value(a) * small_int_value(b));
+    else
+        r.addmul(a, b);
+}
+
+inline double mul(double a, double b) { return a * b; }
+inline mpq mul(mpq const& a, mpq const& b) {
+    if (is_small_int(a) && is_small_int(b)) {
+        mpq r;
+        set_int64(r, small_int_value(a) * small_int_value(b));
+        return r;
+    }
+    return a * b;
+}
 
 template <typename T, typename X>
 void  static_matrix<T, X>::init_row_columns(unsigned m, unsigned n) {
@@ -63,7 +93,7 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
         lp_assert(!is_zero(iv.coeff()));
         int j_offs = m_vector_of_row_offsets[j];
         if (j_offs == -1) { // it is a new element
-            T alv = alpha * iv.coeff();
+            T alv = mul(alpha, iv.coeff());
             add_new_element(ii, j, alv);
         }
         else {
@@ -46,6 +46,39 @@ static void skip_line(Buffer & in) {
     } 
 }
 
+template<typename Buffer>
+static void skip_blanks(Buffer & in) {
+    while (*in == ' ' || *in == '\t')
+        ++in;
+}
+
+template<typename Buffer>
+static unsigned parse_unsigned(Buffer & in) {
+    unsigned val = 0;
+    while (*in >= '0' && *in <= '9') {
+        val = val*10 + (*in - '0');
+        ++in;
+    }
+    return val;
+}
+
+/**
+   \brief parse header 'p cnf <num vars> <num clauses>' and create the declared variables up front.
+*/
+template<typename Buffer>
+static void read_header(Buffer & in, sat::solver & solver) {
+    SASSERT(*in == 'p');
+    ++in;
+    skip_blanks(in);
+    while (*in != EOF && !is_whitespace(in))
+        ++in;
+    skip_blanks(in);
+    unsigned num_vars = parse_unsigned(in);
+    while (num_vars >= solver.num_vars())
+        solver.mk_var();
+    skip_line(in);
+}
+
 template<typename Buffer>
 static int parse_int(Buffer & in, std::ostream& err) {
     int     val = 0;
@@ -123,9 +156,12 @@ static bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solv
             if (*in == EOF) {
                 break;
             }
-            else if (*in == 'c' || *in == 'p') {
+            else if (*in == 'c') {
                 skip_line(in);
             }
+            else if (*in == 'p') {
+                read_header(in, solver);
+            }
             else {
                 read_clause(in, err, solver, lits);
                 solver.mk_clause(lits.size(), lits.data());
@@ -140,7 +176,7 @@ static bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solv
 
 
 bool parse_dimacs(std::istream & in, std::ostream& err, sat::solver & solver) {
-    dimacs::stream_buffer _in(in);
+    dimacs::block_buffer _in(in);
     return parse_dimacs_core(_in, err, solver);
 }
 
@@ -52,6 +52,49 @@ namespace dimacs {
         unsigned line() const { return m_line; }
     };
 
+    /**
+       \brief buffer that reads the stream in large blocks.
+       It avoids a call into the stream for every character when loading large CNF files.
+    */
+    class block_buffer {
+        std::istream & m_stream;
+        svector<char>  m_block;
+        char const*    m_curr = nullptr;
+        char const*    m_end = nullptr;
+        int            m_val = EOF;
+        unsigned       m_line = 0;
+
+        void fill() {
+            m_stream.read(m_block.data(), m_block.size());
+            m_curr = m_block.data();
+            m_end = m_curr + m_stream.gcount();
+        }
+
+    public:
+        block_buffer(std::istream & s):
+            m_stream(s) {
+            m_block.resize(1 << 16);
+            fill();
+            if (m_curr < m_end)
+                m_val = static_cast<unsigned char>(*m_curr);
+        }
+
+        int operator *() const {
+            return m_val;
+        }
+
+        void operator ++() {
+            if (m_curr == m_end)
+                return;
+            if (++m_curr == m_end)
+                fill();
+            m_val = m_curr < m_end ? static_cast<unsigned char>(*m_curr) : EOF;
+            if (m_val == '\n') ++m_line;
+        }
+
+        unsigned line() const { return m_line; }
+    };
+
     struct drat_record {
         // a clause populates m_lits and m_status
         // a node populates m_node_id, m_name, m_args
@@ -113,7 +113,8 @@ namespace sat {
 
 
     void asymm_branch::process(big* big, clause_vector& clauses) {
-        int64_t limit = -m_asymm_branch_limit;
+        int64_t limit = -s.m_inprocess.scale_limit(inprocess::asymm_branch_t, m_asymm_branch_limit);
+        int64_t counter0 = m_counter;
         std::stable_sort(clauses.begin(), clauses.end(), clause_size_lt());
         m_counter -= clauses.size();
         clause_vector::iterator it  = clauses.begin();
@@ -141,6 +142,7 @@ namespace sat {
                 ++it2;
             }
             clauses.set_end(it2);
+            s.m_inprocess.add_ticks(inprocess::asymm_branch_t, counter0 - m_counter);
         }
         catch (solver_exception & ex) {
             // put m_clauses in a consistent state...
@@ -204,6 +206,59 @@ namespace sat {
 
     }
 
+    /**
+       \brief vivify learned clauses with glue at most max_glue.
+       Clauses are processed in the order of the last gc, which ranks the
+       most useful clauses first, so they are strengthened before the others
+       when the budget runs out. Clauses are vivified once; clauses that 
+       could not be strengthened are skipped in later calls.
+    */
+    void asymm_branch::vivify_learned(unsigned max_glue, unsigned limit) {
+        SASSERT(s.at_base_lvl());
+        s.propagate(false);
+        if (s.inconsistent())
+            return;
+        clause_vector& clauses = s.m_learned;
+        flet<int64_t> _counter(m_counter, 0);
+        flet<unsigned> _touch_index(m_touch_index, 0);
+        flet<bool> _is_probing(s.m_is_probing, true);
+        bool_vector saved_phase(s.m_phase);
+        unsigned elim0 = m_elim_learned_literals;
+        int64_t lim = -static_cast<int64_t>(limit);
+        clause_vector::iterator it  = clauses.begin();
+        clause_vector::iterator it2 = it;
+        clause_vector::iterator end = clauses.end();
+        try {
+            for (; it != end; ++it) {
+                clause & c = *(*it);
+                if (s.inconsistent() || m_counter < lim || c.glue() > max_glue || c.vivified() || c.frozen() || c.was_removed()) {
+                    *it2 = *it;
+                    ++it2;
+                    continue;
+                }
+                s.checkpoint();
+                ++m_vivify_clauses;
+                if (!process(c))
+                    continue; // clause was removed
+                c.set_vivified(true);
+                *it2 = *it;
+                ++it2;
+            }
+            clauses.set_end(it2);
+        }
+        catch (solver_exception & ex) {
+            for (; it != end; ++it, ++it2) 
+                *it2 = *it;
+            clauses.set_end(it2);
+            s.m_phase = saved_phase;
+            throw ex;
+        }
+        s.m_phase = saved_phase;
+        m_vivify_literals += m_elim_learned_literals - elim0;
+        IF_VERBOSE(2, verbose_stream() << " (sat-vivify :literals " << (m_elim_learned_literals - elim0) 
+                   << " :cost " << -m_counter << ")\n";);
+    }
+
     /**
        \brief try asymmetric branching on all literals in clause.        
     */
@@ -489,12 +544,16 @@ namespace sat {
     void asymm_branch::collect_statistics(statistics & st) const {
         st.update("sat elim literals", m_elim_literals);
         st.update("sat tr", m_tr);
+        st.update("sat vivify clauses", m_vivify_clauses);
+        st.update("sat vivify literals", m_vivify_literals);
     }
 
     void asymm_branch::reset_statistics() {
         m_elim_literals = 0;
         m_elim_learned_literals = 0;
         m_tr = 0;
+        m_vivify_clauses = 0;
+        m_vivify_literals = 0;
     }
 
 };
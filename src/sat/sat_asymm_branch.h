@@ -49,6 +49,8 @@ namespace sat {
         unsigned   m_elim_literals;
         unsigned   m_elim_learned_literals;
         unsigned   m_tr;
+        unsigned   m_vivify_clauses;
+        unsigned   m_vivify_literals;
 
         literal_vector m_pos, m_neg; // literals (complements of literals) in clauses sorted by discovery time (m_left in BIG).
         svector<std::pair<literal, unsigned>> m_pos1, m_neg1;
@@ -95,6 +97,8 @@ namespace sat {
 
         void operator()(bool force);
 
+        void vivify_learned(unsigned max_glue, unsigned limit);
+
         void updt_params(params_ref const & p);
         static void collect_param_descrs(param_descrs & d);
 
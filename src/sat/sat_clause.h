@@ -50,6 +50,7 @@ namespace sat {
         unsigned           m_used:1;
         unsigned           m_frozen:1;
         unsigned           m_reinit_stack:1;
+        unsigned           m_vivified:1;
         unsigned           m_inact_rounds:8;
         unsigned           m_glue:8;
         unsigned           m_psm:8;  // transient field used during gc
@@ -103,6 +104,9 @@ namespace sat {
 
         bool on_reinit_stack() const { return m_reinit_stack; }
         void set_reinit_stack(bool f) { m_reinit_stack = f; }
+
+        bool vivified() const { return m_vivified; }
+        void set_vivified(bool f) { m_vivified = f; }
     };
 
     std::ostream & operator<<(std::ostream & out, clause_vector const & cs);
@@ -142,6 +146,7 @@ namespace sat {
         clause_allocator();
         void          finalize();
         size_t        get_allocation_size() const { return m_allocator.get_allocation_size(); }
+        size_t        get_free_size() const { return m_allocator.get_free_size(); }
         clause *      get_clause(clause_offset cls_off) const;
         clause_offset get_offset(clause const * ptr) const;
         clause *      mk_clause(unsigned num_lits, literal const * lits, bool learned);
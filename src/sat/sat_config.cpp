@@ -84,6 +84,7 @@ namespace sat {
         m_propagate_prefetch = p.propagate_prefetch();
         m_inprocess_max   = p.inprocess_max();
         m_inprocess_out   = p.inprocess_out();
+        m_inprocess_adaptive = p.inprocess_adaptive();
 
         m_random_freq     = p.random_freq();
         m_random_seed     = p.random_seed();
@@ -96,6 +97,9 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_par_share_glue  = p.threads_share_glue();
+        m_par_share_size  = p.threads_share_size();
+        m_cube_and_conquer = p.cube_and_conquer();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -187,6 +191,9 @@ namespace sat {
         m_gc_k            = std::min(255u, p.gc_k());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
+        m_vivify          = p.vivify();
+        m_vivify_glue     = p.vivify_glue();
+        m_vivify_limit    = p.vivify_limit();
 
         m_force_cleanup   = p.force_cleanup();
 
@@ -210,6 +217,7 @@ namespace sat {
              m_smt_proof_check ||
              m_drat_check_sat);
         m_drat_binary     = p.drat_binary();
+        m_drat_async      = p.drat_async();
         m_drat_activity   = p.drat_activity();
         m_dyn_sub_res     = p.dyn_sub_res();
 
@@ -106,12 +106,16 @@ namespace sat {
         double             m_slow_glue_avg;
         unsigned           m_inprocess_max;
         symbol             m_inprocess_out;
+        bool               m_inprocess_adaptive;
         double             m_random_freq;
         unsigned           m_random_seed;
         unsigned           m_burst_search;
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        unsigned           m_par_share_glue;
+        unsigned           m_par_share_size;
+        bool               m_cube_and_conquer;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -162,6 +166,9 @@ namespace sat {
         unsigned           m_gc_k;
         bool               m_gc_burst;
         bool               m_gc_defrag;
+        bool               m_vivify;
+        unsigned           m_vivify_glue;
+        unsigned           m_vivify_limit;
 
         bool               m_force_cleanup;
 
@@ -178,6 +185,7 @@ namespace sat {
         bool               m_drat;
         bool               m_drat_disable;
         bool               m_drat_binary;
+        bool               m_drat_async;
         symbol             m_drat_file;
         bool               m_smt_proof_check;
         bool               m_drat_check_unsat;
@@ -81,7 +81,7 @@ namespace sat {
         double kflips_per_sec = (m_flips - m_last_flips) / (1000.0 * sec);
         if (m_last_flips == 0) {
             IF_VERBOSE(1, verbose_stream() << "(sat.ddfw :unsat :models :kflips/sec  :flips  :restarts  :reinits  :unsat_vars  :shifts";
-                       if (m_par) verbose_stream() << "  :par";
+                       if (m_par) verbose_stream() << "  :par  :imports";
                        verbose_stream() << ")\n");
         }
         IF_VERBOSE(1, verbose_stream() << "(sat.ddfw " 
@@ -93,7 +93,7 @@ namespace sat {
                    << std::setw(11) << m_reinit_count
                    << std::setw(13) << m_unsat_vars.size()
                    << std::setw(9) << m_shifts;
-                   if (m_par) verbose_stream() << std::setw(10) << m_parsync_count;
+                   if (m_par) verbose_stream() << std::setw(10) << m_parsync_count << std::setw(8) << m_parsync_imports;
                    verbose_stream() << ")\n");
         m_stopwatch.start();
         m_last_flips = m_flips;
@@ -274,6 +274,7 @@ namespace sat {
         m_restart_next = m_config.m_restart_base*2;
 
         m_parsync_count = 0;
+        m_parsync_imports = 0;
         m_parsync_next = m_config.m_parsync_base;
 
         m_min_sz = m_unsat.size();
@@ -458,12 +459,39 @@ namespace sat {
     void ddfw::do_parallel_sync() {
         if (m_par->from_solver(*this)) 
             m_par->to_solver(*this);
+        else
+            share_best();
         
         ++m_parsync_count;
         m_parsync_next *= 3;
         m_parsync_next /= 2;
     }
 
+    /**
+       \brief publish the current assignment and clause weights to other local search threads, 
+       or continue from a shared state that has fewer unsatisfied clauses.
+    */
+    void ddfw::share_best() {
+        bool_vector phase;
+        svector<double> weights;
+        for (unsigned v = 0; v < num_vars(); ++v)
+            phase.push_back(value(v));
+        for (auto const& ci : m_clauses)
+            weights.push_back(ci.m_weight);
+        if (!m_par->exchange_best(m_unsat.size(), phase, weights))
+            return;
+        ++m_parsync_imports;
+        for (unsigned v = 0; v < num_vars(); ++v)
+            value(v) = phase[v];
+        // weights are only meaningful for the same clause set.
+        if (weights.size() == m_clauses.size())
+            for (unsigned i = 0; i < weights.size(); ++i)
+                m_clauses[i].m_weight = weights[i];
+        init_clause_data();
+        if (m_unsat.size() < m_min_sz)
+            save_best_values();
+    }
+
     void ddfw::save_model() {
         m_model.reserve(num_vars());
         for (unsigned i = 0; i < num_vars(); ++i) 
@@ -124,7 +124,7 @@ namespace sat {
         indexed_uint_set m_unsat_vars;  // set of variables that are in unsat clauses
         random_gen       m_rand;
         unsigned         m_num_non_binary_clauses = 0;
-        unsigned         m_restart_count = 0, m_reinit_count = 0, m_parsync_count = 0;
+        unsigned         m_restart_count = 0, m_reinit_count = 0, m_parsync_count = 0, m_parsync_imports = 0;
         uint64_t         m_restart_next = 0, m_reinit_next = 0, m_parsync_next = 0;
         uint64_t         m_flips = 0, m_last_flips = 0, m_shifts = 0;
         unsigned         m_min_sz = 0, m_steps_since_progress = 0;
@@ -232,6 +232,7 @@ namespace sat {
         // parallel integration
         bool should_parallel_sync();
         void do_parallel_sync();
+        void share_best();
 
         void log();
 
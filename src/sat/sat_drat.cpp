@@ -20,11 +20,100 @@ Notes:
 
 --*/
 
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <condition_variable>
+#endif
+#include <sstream>
 #include "util/rational.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_drat.h"
 
 namespace sat {
+
+#ifndef SINGLE_THREAD
+    /**
+       \brief buffered proof output.
+       Full buffers are handed to a background thread that writes them to the proof file.
+       The solver blocks if the previous buffer is still being written, so memory use is 
+       bounded by two buffers.
+    */
+    class drat::writer {
+        static const unsigned   s_buffer_size = 1 << 20;
+        std::ostream&           m_out;
+        svector<char>           m_buffer;    // filled by the solver
+        svector<char>           m_pending;   // written by the background thread
+        bool                    m_has_pending = false;
+        bool                    m_done = false;
+        std::mutex              m_mux;
+        std::condition_variable m_cv;
+        std::thread             m_thread;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(m_mux);
+            while (true) {
+                m_cv.wait(lock, [&] { return m_has_pending || m_done; });
+                if (!m_has_pending)
+                    return;
+                lock.unlock();
+                m_out.write(m_pending.data(), m_pending.size());
+                lock.lock();
+                m_pending.reset();
+                m_has_pending = false;
+                m_cv.notify_all();
+            }
+        }
+
+        void wait_pending(std::unique_lock<std::mutex>& lock) {
+            m_cv.wait(lock, [&] { return !m_has_pending; });
+        }
+
+        void hand_off() {
+            std::unique_lock<std::mutex> lock(m_mux);
+            wait_pending(lock);
+            m_pending.swap(m_buffer);
+            m_has_pending = true;
+            m_cv.notify_all();
+        }
+
+    public:
+        writer(std::ostream& out): m_out(out), m_thread([this]() { run(); }) {}
+
+        ~writer() {
+            flush();
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_done = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+        }
+
+        void write(char const* data, unsigned len) {
+            m_buffer.append(len, data);
+            if (m_buffer.size() >= s_buffer_size)
+                hand_off();
+        }
+
+        /**
+           \brief block until all buffered output has been written to the stream.
+        */
+        void flush() {
+            if (!m_buffer.empty())
+                hand_off();
+            std::unique_lock<std::mutex> lock(m_mux);
+            wait_pending(lock);
+        }
+    };
+#else
+    class drat::writer {
+        std::ostream& m_out;
+    public:
+        writer(std::ostream& out): m_out(out) {}
+        void write(char const* data, unsigned len) { m_out.write(data, len); }
+        void flush() {}
+    };
+#endif
     
     drat::drat(solver& s) :
         s(s)
@@ -32,12 +121,16 @@ namespace sat {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
             m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
+            if (s.get_config().m_drat_async)
+                m_writer = alloc(writer, *m_out);
             if (s.get_config().m_drat_binary) 
                 std::swap(m_out, m_bout);            
         }
     }
 
     drat::~drat() {
+        dealloc(m_writer);
+        m_writer = nullptr;
         if (m_out) m_out->flush();
         if (m_bout) m_bout->flush();
         dealloc(m_out);
@@ -56,6 +149,21 @@ namespace sat {
         m_activity    = s.get_config().m_drat_activity;
     }
 
+    std::ostream* drat::out() {
+        if (m_writer)
+            m_writer->flush();
+        return m_out;
+    }
+
+    void drat::write(char const* data, unsigned len) {
+        if (m_writer)
+            m_writer->write(data, len);
+        else if (m_out)
+            m_out->write(data, len);
+        else
+            m_bout->write(data, len);
+    }
+
     std::ostream& drat::pp(std::ostream& out, status st) const {
         if (st.is_deleted())
             out << "d";
@@ -110,20 +218,23 @@ namespace sat {
             len += static_cast<unsigned>(lastd - d);
             buffer[len++] = ' ';
             if (static_cast<size_t>(len) + 50 > sizeof(buffer)) {
-                m_out->write(buffer, len);
+                write(buffer, len);
                 len = 0;
             }
         }
         buffer[len++] = '0';
         buffer[len++] = '\n';
-        m_out->write(buffer, len);
+        write(buffer, len);
     }
 
     void drat::dump_activity() {
-        (*m_out) << "c activity ";
+        std::ostringstream strm;
+        strm << "c activity ";
         for (unsigned v = 0; v < s.num_vars(); ++v) 
-            (*m_out) << s.m_activity[v] << " ";
-        (*m_out) << "\n";
+            strm << s.m_activity[v] << " ";
+        strm << "\n";
+        std::string str = strm.str();
+        write(str.data(), static_cast<unsigned>(str.size()));
     }
 
     void drat::bdump(unsigned n, literal const* c, status st) {
@@ -146,14 +257,14 @@ namespace sat {
                 if (v) ch |= 128;
                 buffer[len++] = ch;
                 if (len == sizeof(buffer)) {
-                    m_bout->write(buffer, len);
+                    write(buffer, len);
                     len = 0;
                 }
             }
             while (v);
         }
         buffer[len++] = 0;
-        m_bout->write(buffer, len);
+        write(buffer, len);
     }
 
     bool drat::is_cleaned(clause& c) const {
@@ -626,7 +737,7 @@ namespace sat {
 
     void drat::add() {
         ++m_stats.m_num_add;
-        if (m_out) (*m_out) << "0\n";
+        if (m_out) write("0\n", 2);
         if (m_bout) bdump(0, nullptr, status::redundant());
         if (m_check_unsat) {
             verify(0, nullptr);
@@ -39,6 +39,7 @@ namespace sat {
             unsigned m_num_add = 0;
             unsigned m_num_del = 0;
         };
+        class writer;
         struct watched_clause {
             clause* m_clause;
             literal m_l1, m_l2;
@@ -52,6 +53,7 @@ namespace sat {
         clause_allocator        m_alloc;
         std::ostream*           m_out = nullptr;
         std::ostream*           m_bout = nullptr;
+        writer*                 m_writer = nullptr;
         svector<std::pair<clause&, status>> m_proof;
         svector<std::pair<literal, clause*>> m_units;
         vector<watch>           m_watches;
@@ -64,6 +66,7 @@ namespace sat {
         stats                   m_stats;
 
 
+        void write(char const* data, unsigned len);
         void dump_activity();
         void dump(unsigned n, literal const* c, status st);
         void bdump(unsigned n, literal const* c, status st);
@@ -111,7 +114,7 @@ namespace sat {
 
         void set_clause_eh(clause_eh& clause_eh) { m_clause_eh = &clause_eh; }
 
-        std::ostream* out() { return m_out; }
+        std::ostream* out();
 
         bool is_cleaned(clause& c) const;        
         void del(literal l);
@@ -69,12 +69,29 @@ namespace sat {
             break;
         }
         if (m_ext) m_ext->gc();
+        // vivification needs the base level, it runs at the next restart.
+        if (m_config.m_vivify)
+            m_vivify_pending = true;
         if (gc > 0 && should_defrag()) {
             defrag_clauses();
         }
         CASSERT("sat_gc_bug", check_invariant());
     }
 
+    /**
+       \brief Vivify learned clauses of the core and mid tiers
+       that have not been vivified since they were learned.
+       It is scheduled by gc and replaces the next restart, which
+       then backtracks to the base level.
+    */
+    void solver::vivify_learned() {
+        m_vivify_pending = false;
+        pop(scope_lvl());
+        if (!inconsistent())
+            m_asymm_branch.vivify_learned(m_config.m_vivify_glue, m_config.m_vivify_limit);
+        pop_reinit(0);
+    }
+
     /**
        \brief Lex on (glue, size)
     */
@@ -0,0 +1,155 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.cpp
+
+Abstract:
+
+    Scheduler for inprocessing techniques.
+
+--*/
+
+#include "sat/sat_inprocess.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    static char const* s_calls_key[inprocess::num_techniques] = {
+        "sat inprocess scc calls", "sat inprocess simplifier calls", "sat inprocess probing calls",
+        "sat inprocess asymm branch calls", "sat inprocess cut calls"
+    };
+    static char const* s_time_key[inprocess::num_techniques] = {
+        "sat inprocess scc time", "sat inprocess simplifier time", "sat inprocess probing time",
+        "sat inprocess asymm branch time", "sat inprocess cut time"
+    };
+    static char const* s_effect_key[inprocess::num_techniques] = {
+        "sat inprocess scc removed", "sat inprocess simplifier removed", "sat inprocess probing removed",
+        "sat inprocess asymm branch removed", "sat inprocess cut removed"
+    };
+    static char const* s_ticks_key[inprocess::num_techniques] = {
+        "sat inprocess scc ticks", "sat inprocess simplifier ticks", "sat inprocess probing ticks",
+        "sat inprocess asymm branch ticks", "sat inprocess cut ticks"
+    };
+
+    /**
+       \brief number of literal occurrences in the clause database,
+       where each binary clause contributes its two literals.
+     */
+    uint64_t inprocess::num_literals() const {
+        uint64_t n = 0;
+        for (clause* c : s.m_clauses)
+            n += c->size();
+        for (clause* c : s.m_learned)
+            n += c->size();
+        for (watch_list const& wlist : s.m_watches)
+            for (watched const& w : wlist)
+                if (w.is_binary_clause())
+                    ++n;
+        return n;
+    }
+
+    inprocess::scope::scope(inprocess& ip, technique t):
+        m_ip(ip),
+        m_t(t),
+        m_lits(ip.m_adaptive ? ip.num_literals() : 0),
+        m_units(ip.s.init_trail_size()) {
+        m_ip.m_info[t].m_pending_ticks = 0;
+        m_watch.start();
+    }
+
+    inprocess::scope::~scope() {
+        m_watch.stop();
+        info& i = m_ip.m_info[m_t];
+        uint64_t ticks = i.m_pending_ticks;
+        i.m_pending_ticks = 0;
+        i.m_time += m_watch.get_seconds();
+        if (!m_ip.m_adaptive) {
+            // the effect is not measured, counting literals visits the clause database.
+            i.m_calls++;
+            i.m_ticks += ticks;
+            return;
+        }
+        uint64_t lits = m_ip.num_literals();
+        uint64_t effect = (lits < m_lits ? m_lits - lits : 0);
+        unsigned units = m_ip.s.init_trail_size();
+        effect += (units > m_units ? units - m_units : 0);
+        // passes without a tick counter are linear in the size of the clause database.
+        if (!is_budgeted(m_t))
+            ticks = m_lits;
+        if (ticks == 0)
+            return;
+        i.m_calls++;
+        i.m_effect += effect;
+        i.m_ticks += ticks;
+        double e = static_cast<double>(effect) / static_cast<double>(ticks);
+        i.m_efficiency = i.m_calls == 1 ? e : (i.m_efficiency + e) / 2;
+        i.m_updated = true;
+    }
+
+    unsigned inprocess::scale_limit(technique t, unsigned limit) const {
+        return static_cast<unsigned>(scale_limit(t, static_cast<int64_t>(limit)));
+    }
+
+    int64_t inprocess::scale_limit(technique t, int64_t limit) const {
+        SASSERT(is_budgeted(t));
+        // limits are negated and compared with int counters, so they are clamped to INT_MAX.
+        double d = m_info[t].m_scale * static_cast<double>(limit);
+        return d >= static_cast<double>(INT_MAX) ? INT_MAX : static_cast<int64_t>(d);
+    }
+
+    void inprocess::update_budgets() {
+        double sum = 0;
+        unsigned n = 0;
+        bool updated = false;
+        for (unsigned t = 0; t < num_techniques; ++t) {
+            info const& i = m_info[t];
+            if (!is_budgeted(static_cast<technique>(t)) || i.m_calls == 0)
+                continue;
+            sum += i.m_efficiency;
+            ++n;
+            updated |= i.m_updated;
+        }
+        for (info& i : m_info)
+            i.m_updated = false;
+        if (!m_adaptive || !updated || n == 0)
+            return;
+        double mean = sum / n;
+        for (unsigned t = 0; t < num_techniques; ++t) {
+            info& i = m_info[t];
+            if (!is_budgeted(static_cast<technique>(t)) || i.m_calls == 0)
+                continue;
+            if (mean == 0)
+                i.m_scale /= 2;
+            else
+                i.m_scale = i.m_efficiency / mean;
+            i.m_scale = std::max(m_min_scale, std::min(m_max_scale, i.m_scale));
+        }
+        IF_VERBOSE(3,
+                   verbose_stream() << "(sat.inprocess";
+                   for (unsigned t = 0; t < num_techniques; ++t)
+                       if (is_budgeted(static_cast<technique>(t)))
+                           verbose_stream() << " " << m_info[t].m_scale;
+                   verbose_stream() << ")\n";);
+    }
+
+    void inprocess::collect_statistics(statistics& st) const {
+        for (unsigned t = 0; t < num_techniques; ++t) {
+            info const& i = m_info[t];
+            st.update(s_calls_key[t], i.m_calls);
+            st.update(s_time_key[t], i.m_time);
+            st.update(s_effect_key[t], static_cast<unsigned>(std::min<uint64_t>(i.m_effect, UINT_MAX)));
+            st.update(s_ticks_key[t], static_cast<unsigned>(std::min<uint64_t>(i.m_ticks, UINT_MAX)));
+        }
+    }
+
+    void inprocess::reset_statistics() {
+        for (info& i : m_info) {
+            i.m_calls = 0;
+            i.m_time = 0;
+            i.m_effect = 0;
+            i.m_ticks = 0;
+        }
+    }
+};
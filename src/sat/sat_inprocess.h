@@ -0,0 +1,106 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.h
+
+Abstract:
+
+    Scheduler for inprocessing techniques.
+
+    Each inprocessing pass is measured for time, ticks (approximate
+    number of literals visited) and effect (literals removed from the
+    clause database and new units). The effect is only measured with
+    adaptive budgets, since it counts the literals of the clause database.
+    Techniques that are bounded by a tick limit (subsumption/resolution,
+    probing and asymmetric branching) can have their limit scaled in
+    proportion to their effectiveness, measured as effect per tick,
+    relative to the other techniques. The budgets are updated
+    deterministically after each simplification round.
+
+    Passes that exhaust their budget stop and resume at the next round
+    using the technique's own bookkeeping (for example, probing continues
+    from the variable where it stopped).
+
+--*/
+#pragma once
+
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+    class solver;
+
+    class inprocess {
+    public:
+        enum technique {
+            scc_t = 0,
+            simplifier_t,
+            probing_t,
+            asymm_branch_t,
+            cut_simplifier_t,
+            num_techniques
+        };
+
+    private:
+        struct info {
+            unsigned m_calls { 0 };
+            double   m_time { 0 };
+            uint64_t m_effect { 0 };
+            uint64_t m_ticks { 0 };
+            uint64_t m_pending_ticks { 0 };
+            double   m_efficiency { 0 };  // moving average of effect per tick
+            double   m_scale { 1 };       // budget multiplier
+            bool     m_updated { false }; // ran in the current round
+        };
+
+        solver&  s;
+        info     m_info[num_techniques];
+        bool     m_adaptive { false };
+        double   m_min_scale { 0.125 };
+        double   m_max_scale { 8 };
+
+        static bool is_budgeted(technique t) { return t == simplifier_t || t == probing_t || t == asymm_branch_t; }
+
+        uint64_t num_literals() const;
+
+    public:
+
+        inprocess(solver& s): s(s) {}
+
+        class scope {
+            inprocess& m_ip;
+            technique  m_t;
+            uint64_t   m_lits;
+            unsigned   m_units;
+            stopwatch  m_watch;
+        public:
+            scope(inprocess& ip, technique t);
+            ~scope();
+        };
+
+        void set_adaptive(bool f) { m_adaptive = f; }
+
+        /**
+           \brief scale a tick limit of a budgeted technique by its current budget.
+           The result is at most INT_MAX.
+         */
+        unsigned scale_limit(technique t, unsigned limit) const;
+        int64_t scale_limit(technique t, int64_t limit) const;
+
+        /**
+           \brief record ticks consumed by the current pass of technique t.
+         */
+        void add_ticks(technique t, uint64_t ticks) { m_info[t].m_pending_ticks += ticks; }
+
+        /**
+           \brief update budgets based on the passes in the last round.
+         */
+        void update_budgets();
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics();
+    };
+};
@@ -24,7 +24,7 @@ namespace sat {
 
     void parallel::vector_pool::next(unsigned& index) {
         SASSERT(index < m_size);
-        unsigned n = index + 2 + get_length(index);
+        unsigned n = index + 3 + get_length(index);
         index = (n >= m_size) ? 0 : n;
     }
 
@@ -39,9 +39,9 @@ namespace sat {
         m_size = sz;
     }
     
-    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n) {
+    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n, unsigned glue) {
         SASSERT(m_tail < m_size);
-        unsigned capacity = n + 2;
+        unsigned capacity = n + 3;
         m_vectors.reserve(m_size + capacity, 0);
         IF_VERBOSE(3, verbose_stream() << owner << ": begin-add " << n << " tail: " << m_tail << " size: " << m_size << "\n";);
         for (unsigned i = 0; i < m_heads.size(); ++i) {
@@ -51,7 +51,8 @@ namespace sat {
             m_at_end[i] = false;
         }
         m_vectors[m_tail++] = owner;
-        m_vectors[m_tail++] = n;    
+        m_vectors[m_tail++] = n;
+        m_vectors[m_tail++] = glue;
     }
 
     void parallel::vector_pool::add_vector_elem(unsigned e) {
@@ -64,7 +65,7 @@ namespace sat {
     }
 
 
-    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned const*& ptr) {
+    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned& glue, unsigned const*& ptr) {
         unsigned head = m_heads[owner];      
         unsigned iterations = 0;
         while (head != m_tail || !m_at_end[owner]) {
@@ -76,6 +77,7 @@ namespace sat {
             m_at_end[owner] = (m_heads[owner] == m_tail);
             if (!is_self) {
                 n = get_length(head);
+                glue = get_glue(head);
                 ptr = get_ptr(head);
                 return true;
             }
@@ -115,6 +117,16 @@ namespace sat {
         m_scoped_rlimit.push_child(&rl);            
     }
 
+    void parallel::reserve(unsigned num_owners, unsigned sz) {
+        m_pools.reset();
+        for (unsigned i = 0; i < num_owners; ++i) {
+            m_pools.push_back(alloc(export_pool));
+            m_pools.back()->m_pool.reserve(num_owners, sz);
+        }
+        m_share_stats.reset();
+        m_share_stats.resize(num_owners);
+    }
+
 
     void parallel::exchange(solver& s, literal_vector const& in, unsigned& limit, literal_vector& out) {
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
@@ -139,59 +151,114 @@ namespace sat {
     void parallel::share_clause(solver& s, literal l1, literal l2) {        
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
+        unsigned owner = s.m_par_id;
+        IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  l1 << " " << l2 << "\n";);
+        export_pool& p = *m_pools[owner];
         {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
+            lock_guard lock(p.m_mux);
+            p.m_pool.begin_add_vector(owner, 2, 2);
+            p.m_pool.add_vector_elem(l1.index());
+            p.m_pool.add_vector_elem(l2.index());            
+            p.m_pool.end_add_vector();
         }        
+        m_share_stats[owner].m_exported++;
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
-        if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
+        if (s.get_config().m_num_threads == 1 || !enable_add(s, c) || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         unsigned n = c.size();
         unsigned owner = s.m_par_id;
         IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) 
-            m_pool.add_vector_elem(c[i].index());
-        m_pool.end_add_vector();        
+        export_pool& p = *m_pools[owner];
+        {
+            lock_guard lock(p.m_mux);
+            p.m_pool.begin_add_vector(owner, n, c.glue());
+            for (unsigned i = 0; i < n; ++i) 
+                p.m_pool.add_vector_elem(c[i].index());
+            p.m_pool.end_add_vector();
+        }
+        m_share_stats[owner].m_exported++;
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
-        _get_clauses(s);        
-    }
-
-    void parallel::_get_clauses(solver& s) {
-        unsigned n;
-        unsigned const* ptr;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
-            bool usable_clause = true;
-            for (unsigned i = 0; usable_clause && i < n; ++i) {
-                literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
-                usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
+        unsigned_vector buffer;
+        unsigned n, glue;
+        unsigned const* ptr;
+        for (unsigned i = 0; i < m_pools.size(); ++i) {
+            if (i == owner)
+                continue;
+            // copy clauses out of the pool and release the lock
+            // before adding them to the solver.
+            buffer.reset();
+            {
+                export_pool& p = *m_pools[i];
+                lock_guard lock(p.m_mux);
+                while (p.m_pool.get_vector(owner, n, glue, ptr)) {
+                    buffer.push_back(n);
+                    buffer.push_back(glue);
+                    buffer.append(n, ptr);
+                }
             }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
+            _get_clauses(s, buffer);
+        }
+    }
+
+    void parallel::_get_clauses(solver& s, unsigned_vector const& buffer) {
+        literal_vector lits;
+        share_stats& st = m_share_stats[s.m_par_id];
+        for (unsigned j = 0; j < buffer.size(); ) {
+            unsigned n = buffer[j++];
+            unsigned glue = buffer[j++];
             SASSERT(n >= 2);
-            if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+            lits.reset();
+            bool usable_clause = true;
+            bool is_sat = false;
+            for (unsigned i = 0; i < n; ++i) {
+                literal lit(to_literal(buffer[j + i]));
+                lits.push_back(lit);
+                usable_clause = usable_clause && lit.var() < s.m_par_num_vars && !s.was_eliminated(lit.var());
+                is_sat = is_sat || (usable_clause && s.value(lit) == l_true && s.lvl(lit) == 0);
             }
+            j += n;
+            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << lits << "\n";);
+            if (!usable_clause)
+                continue;
+            st.m_imported++;
+            // clauses satisfied at the base level are not useful to the importing solver.
+            if (is_sat)
+                continue;
+            st.m_useful++;
+            clause* c = s.mk_clause_core(lits.size(), lits.data(), sat::status::redundant());
+            if (c)
+                c->set_glue(glue);
         }        
     }
 
-    bool parallel::enable_add(clause const& c) const {
+    bool parallel::enable_add(solver const& s, clause const& c) const {
         // plingeling, glucose heuristic:
-        return (c.size() <= 40 && c.glue() <= 8) || c.glue() <= 2;
+        config const& cfg = s.get_config();
+        return (c.size() <= cfg.m_par_share_size && c.glue() <= cfg.m_par_share_glue) || c.glue() <= 2;
+    }
+
+    void parallel::collect_statistics(stats& st) const {
+        unsigned exported = 0, imported = 0, useful = 0;
+        for (unsigned i = 0; i < m_share_stats.size(); ++i) {
+            share_stats const& ss = m_share_stats[i];
+            if (ss.m_exported == 0 && ss.m_imported == 0)
+                continue;
+            IF_VERBOSE(1, verbose_stream() << "(sat-parallel :thread " << i << " :exported " << ss.m_exported 
+                       << " :imported " << ss.m_imported << " :useful " << ss.m_useful << ")\n";);
+            exported += ss.m_exported;
+            imported += ss.m_imported;
+            useful += ss.m_useful;
+        }
+        st.m_par_exported += exported;
+        st.m_par_imported += imported;
+        st.m_par_useful += useful;
     }
 
     void parallel::_from_solver(solver& s) {
@@ -258,6 +325,26 @@ namespace sat {
         _to_solver(s);               
     }
 
+    bool parallel::exchange_best(unsigned num_unsat, bool_vector& phase, svector<double>& weights) {
+        lock_guard lock(m_mux);
+        if (num_unsat < m_ls_min_unsat) {
+            m_ls_min_unsat = num_unsat;
+            m_ls_phase.reset();
+            m_ls_phase.append(phase);
+            m_ls_weights.reset();
+            m_ls_weights.append(weights);
+            return false;
+        }
+        if (m_ls_min_unsat < num_unsat && m_ls_phase.size() == phase.size()) {
+            phase.reset();
+            phase.append(m_ls_phase);
+            weights.reset();
+            weights.append(m_ls_weights);
+            return true;
+        }
+        return false;
+    }
+
     bool parallel::copy_solver(solver& s) {
         bool copied = false;
         lock_guard lock(m_mux);
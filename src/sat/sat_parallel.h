@@ -27,9 +27,11 @@ Revision History:
 
 namespace sat {
 
+    struct stats;
+
     class parallel {
 
-        // shared pool of learned clauses.
+        // pool of learned clauses.
         class vector_pool {
             unsigned_vector m_vectors;
             unsigned        m_size{ 0 };
@@ -39,17 +41,32 @@ namespace sat {
             void next(unsigned& index);
             unsigned get_owner(unsigned index) const { return m_vectors[index]; }
             unsigned get_length(unsigned index) const { return m_vectors[index+1]; }
-            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 2; }
+            unsigned get_glue(unsigned index) const { return m_vectors[index+2]; }
+            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 3; }
         public:
             void reserve(unsigned num_owners, unsigned sz);
-            void begin_add_vector(unsigned owner, unsigned n);
+            void begin_add_vector(unsigned owner, unsigned n, unsigned glue);
             void end_add_vector();
             void add_vector_elem(unsigned e);
-            bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
+            bool get_vector(unsigned owner, unsigned& n, unsigned& glue, unsigned const*& ptr);
+        };
+
+        // clauses exported by a single thread.
+        // Only the owner appends to the pool, so threads that export
+        // clauses do not contend with each other for a global lock.
+        struct export_pool {
+            vector_pool m_pool;
+            mutex       m_mux;
+        };
+
+        struct share_stats {
+            unsigned m_exported{ 0 };
+            unsigned m_imported{ 0 };
+            unsigned m_useful{ 0 };
         };
 
-        bool enable_add(clause const& c) const;
-        void _get_clauses(solver& s);
+        bool enable_add(solver const& s, clause const& c) const;
+        void _get_clauses(solver& s, unsigned_vector const& buffer);
         void _from_solver(solver& s);
         void _to_solver(solver& s);
         bool _from_solver(i_local_search& s);
@@ -58,8 +75,8 @@ namespace sat {
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
-        vector_pool    m_pool;
+        scoped_ptr_vector<export_pool> m_pools;
+        svector<share_stats> m_share_stats;
         mutex          m_mux;
 
         // for exchange with local search:
@@ -68,6 +85,11 @@ namespace sat {
         bool               m_consumer_ready;
         svector<double>    m_priorities;
 
+        // best assignment and clause weights among local search threads:
+        unsigned           m_ls_min_unsat { UINT_MAX };
+        bool_vector        m_ls_phase;
+        svector<double>    m_ls_weights;
+
         scoped_limits      m_scoped_rlimit;
         vector<reslimit>   m_limits;
         ptr_vector<solver> m_solvers;
@@ -83,7 +105,7 @@ namespace sat {
         void push_child(reslimit& rl);
 
         // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        void reserve(unsigned num_owners, unsigned sz);
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
@@ -108,6 +130,14 @@ namespace sat {
         void to_solver(i_local_search& s);
         
         bool copy_solver(solver& s);
+
+        // exchange the best assignment and clause weights between local search threads.
+        // The caller's state is published if it has fewer unsatisfied clauses than the shared state.
+        // Otherwise, if the shared state is better, it is copied to phase and weights, and the result is true.
+        bool exchange_best(unsigned num_unsat, bool_vector& phase, svector<double>& weights);
+
+        // add clause sharing statistics to the solver statistics.
+        void collect_statistics(stats& st) const;
     };
 
 };
@@ -243,7 +243,7 @@ namespace sat {
         m_counter = 0;
         m_equivs.reset();
         m_big.init(s, true);
-        int limit = -static_cast<int>(m_probing_limit);
+        int limit = -static_cast<int>(s.m_inprocess.scale_limit(inprocess::probing_t, m_probing_limit));
         unsigned i;
         unsigned num = s.num_vars();
         for (i = 0; i < num; i++) {
@@ -270,6 +270,7 @@ namespace sat {
         if (r)
             m_stopped_at = 0;
         m_counter = -m_counter;
+        s.m_inprocess.add_ticks(inprocess::probing_t, m_counter);
         if (rpt.m_num_assigned == m_num_assigned) {
             // penalize
             m_counter *= 2;
@@ -219,8 +219,10 @@ namespace sat {
             m_num_calls++;
         }
 
-        m_sub_counter  = m_subsumption_limit;
-        m_elim_counter = m_res_limit;
+        unsigned sub_limit = s.m_inprocess.scale_limit(inprocess::simplifier_t, m_subsumption_limit);
+        unsigned res_limit = s.m_inprocess.scale_limit(inprocess::simplifier_t, m_res_limit);
+        m_sub_counter  = sub_limit;
+        m_elim_counter = res_limit;
         m_old_num_elim_vars = m_num_elim_vars;
 
         for (bool_var v = 0; v < s.num_vars(); ++v) {
@@ -244,6 +246,8 @@ namespace sat {
             ++count;
         }
         while (!m_sub_todo.empty() && count < 20);
+        s.m_inprocess.add_ticks(inprocess::simplifier_t, 
+                                static_cast<int64_t>(sub_limit) - m_sub_counter + static_cast<int64_t>(res_limit) - m_elim_counter);
         bool vars_eliminated = m_num_elim_vars > m_old_num_elim_vars;
 
         if (m_need_cleanup || vars_eliminated) {
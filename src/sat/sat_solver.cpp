@@ -21,6 +21,7 @@ Revision History:
 #include <cmath>
 #ifndef SINGLE_THREAD
 #include <thread>
+#include <condition_variable>
 #endif
 #include "util/luby.h"
 #include "util/trace.h"
@@ -53,6 +54,7 @@ namespace sat {
         m_scc(*this, p),
         m_asymm_branch(*this, p),
         m_probing(*this, p),
+        m_inprocess(*this),
         m_mus(*this),
         m_binspr(*this),
         m_inconsistent(false),
@@ -122,6 +124,7 @@ namespace sat {
         del_clauses(m_clauses);
         del_clauses(m_learned);
         m_watches.reset();
+        m_bin_prefix.reset();
         m_assignment.reset();
         m_justification.reset();
         m_decision.reset();
@@ -295,6 +298,8 @@ namespace sat {
         m_active_vars.push_back(v);
         m_watches.push_back(watch_list());
         m_watches.push_back(watch_list());
+        m_bin_prefix.push_back(0);
+        m_bin_prefix.push_back(0);
         m_assignment.push_back(l_undef);
         m_assignment.push_back(l_undef);
         m_justification.push_back(justification(UINT_MAX));
@@ -496,8 +501,8 @@ namespace sat {
         else if (has_variables_to_reinit(l1, l2))
             push_reinit_stack(l1, l2);
         m_stats.m_mk_bin_clause++;
-        get_wlist(~l1).push_back(watched(l2, redundant));
-        get_wlist(~l2).push_back(watched(l1, redundant));
+        insert_binary_watch(get_wlist(~l1), watched(l2, redundant), m_bin_prefix[(~l1).index()]);
+        insert_binary_watch(get_wlist(~l2), watched(l1, redundant), m_bin_prefix[(~l2).index()]);
     }
 
     bool solver::has_variables_to_reinit(clause const& c) const {
@@ -655,16 +660,24 @@ namespace sat {
         }
     };
 
+    /**
+       \brief defragment every other garbage collection, or right away when 
+       more than a quarter of the clause memory sits in free lists.
+    */
     bool solver::should_defrag() {
         if (m_defrag_threshold > 0) --m_defrag_threshold;
-        return m_defrag_threshold == 0 && m_config.m_gc_defrag;
+        if (!m_config.m_gc_defrag)
+            return false;
+        size_t free_size = cls_allocator().get_free_size();
+        return m_defrag_threshold == 0 || free_size > cls_allocator().get_allocation_size() / 3;
     }
 
     void solver::defrag_clauses() {
         m_defrag_threshold = 2;
         if (memory_pressure()) return;
         pop(scope_lvl());
-        IF_VERBOSE(2, verbose_stream() << "(sat-defrag)\n");
+        ++m_stats.m_defrag;
+        IF_VERBOSE(2, verbose_stream() << "(sat-defrag :free " << cls_allocator().get_free_size() << " :allocated " << cls_allocator().get_allocation_size() << ")\n");
         clause_allocator& alloc = m_cls_allocator[!m_cls_allocator_idx];
         ptr_vector<clause> new_clauses, new_learned;
         for (clause* c : m_clauses) c->unmark_used();
@@ -1032,6 +1045,23 @@ namespace sat {
                     *it2 = *it;                 \
                 wlist.set_end(it2);             \
             }
+        // binary watches are kept as a prefix of the watch list.
+        // They are propagated first without touching clause memory.
+        for (; it != end && it->is_binary_clause(); ++it) {
+            l1 = it->get_literal();
+            switch (value(l1)) {
+            case l_false:
+                set_conflict(justification(curr_level, not_l), ~l1);
+                return false;
+            case l_undef:
+                m_stats.m_bin_propagate++;
+                assign_core(l1, justification(curr_level, not_l));
+                break;
+            case l_true:
+                break;
+            }
+        }
+        it2 = it;
         for (; it != end; ++it) {
             switch (it->get_kind()) {
             case watched::BINARY:
@@ -1243,6 +1273,10 @@ namespace sat {
             m_cleaner(true);
             return do_local_search(num_lits, lits);
         }
+        if (m_config.m_cube_and_conquer && !m_par && !m_ext && num_lits == 0 && m_user_scope_literals.empty()) {
+            SASSERT(scope_lvl() == 0);
+            return check_cube_and_conquer();
+        }
         if ((m_config.m_num_threads > 1 || m_config.m_local_search_threads > 0 || 
              m_config.m_ddfw_threads > 0) && !m_par && !m_ext) {
             SASSERT(scope_lvl() == 0);
@@ -1580,6 +1614,7 @@ namespace sat {
         if (IS_AUX_SOLVER(finished_id)) {
             m_stats = par.get_solver(finished_id).m_stats;
         }
+        par.collect_statistics(m_stats);
         if (result == l_true && IS_AUX_SOLVER(finished_id)) {
             set_model(par.get_solver(finished_id).get_model(), true);
         }
@@ -1607,6 +1642,192 @@ namespace sat {
     }
 #endif
 
+#ifdef SINGLE_THREAD
+    lbool solver::check_cube_and_conquer() {
+        return l_undef;
+    }
+#else
+    /**
+       \brief cube and conquer.
+       The calling thread splits the search space into cubes using lookahead.
+       Worker solvers, one per thread, take cubes from a shared queue and solve them 
+       as assumptions, such that learned clauses are retained across cubes.
+       Units learned by a worker are imported by the other workers before their next cube.
+       The search ends when a worker finds a model, or when lookahead has covered the 
+       search space and all cubes are refuted.
+     */
+    lbool solver::check_cube_and_conquer() {
+        if (!rlimit().inc()) 
+            return l_undef;
+        unsigned num_workers = std::max(1u, m_config.m_num_threads);
+        params_ref p;
+        p.copy(m_params);
+        p.set_uint("threads", 1);
+        p.set_uint("local_search_threads", 0);
+        p.set_uint("ddfw.threads", 0);
+        p.set_bool("cube_and_conquer", false);
+        p.set_bool("drat.disable", true);
+        vector<reslimit> lims(num_workers);
+        scoped_ptr_vector<solver> workers;
+        scoped_limits scoped_rl(rlimit());
+        for (unsigned i = 0; i < num_workers; ++i) {
+            p.set_uint("random_seed", m_rand());
+            solver* w = alloc(solver, p, lims[i]);
+            w->copy(*this, true);
+            workers.push_back(w);
+            scoped_rl.push_child(&w->rlimit());
+        }
+        unsigned num_vars = this->num_vars();
+
+        std::mutex mux;
+        std::condition_variable cv;
+        vector<literal_vector> cubes;
+        unsigned head = 0;
+        unsigned num_busy = 0;
+        bool generating = true;
+        bool done = false;
+        bool canceled = false;
+        lbool result = l_undef;
+        int winner = -1;
+        literal_vector units;
+        unsigned num_refuted = 0, num_cubes = 0;
+
+        auto finish = [&](lbool r, int i) {
+            // assumes mux is held
+            if (done)
+                return;
+            done = true;
+            result = r;
+            winner = i;
+            for (unsigned j = 0; j < num_workers; ++j) 
+                if (static_cast<int>(j) != i) 
+                    lims[j].cancel();
+            // stop cube generation in the main thread
+            canceled = !rlimit().inc();
+            if (!canceled) 
+                rlimit().cancel();
+            cv.notify_all();
+        };
+
+        auto worker_thread = [&](unsigned i) {
+            solver& w = *workers[i];
+            unsigned units_in = 0, units_out = w.init_trail_size();
+            literal_vector cube, in;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(mux);
+                    cv.wait(lock, [&] { return done || head < cubes.size() || (!generating && num_busy == 0); });
+                    if (done) 
+                        return;
+                    if (head == cubes.size()) {
+                        finish(l_false, -1);
+                        return;
+                    }
+                    cube.reset();
+                    cube.append(cubes[head++]);
+                    in.reset();
+                    for (; units_in < units.size(); ++units_in) 
+                        in.push_back(units[units_in]);
+                    ++num_busy;
+                }
+                lbool r = l_undef;
+                try {
+                    w.pop_to_base_level();
+                    for (literal lit : in) 
+                        if (!w.was_eliminated(lit.var()) && w.value(lit) != l_true)
+                            w.mk_clause(1, &lit);
+                    r = w.check(cube.size(), cube.data());
+                }
+                catch (z3_exception&) {
+                    r = l_undef;
+                }
+                std::lock_guard<std::mutex> lock(mux);
+                --num_busy;
+                if (r == l_true) 
+                    finish(l_true, i);
+                else if (r == l_undef) 
+                    finish(l_undef, -1);
+                else if (w.get_core().empty()) 
+                    finish(l_false, i);
+                else {
+                    ++num_refuted;
+                    unsigned sz = w.init_trail_size();
+                    units_out = std::min(units_out, sz);
+                    for (; units_out < sz; ++units_out) 
+                        if (w.m_trail[units_out].var() < num_vars)
+                            units.push_back(w.m_trail[units_out]);
+                    cv.notify_all();
+                }
+            }
+        };
+
+        vector<std::thread> threads(num_workers);
+        for (unsigned i = 0; i < num_workers; ++i) 
+            threads[i] = std::thread([&, i]() { worker_thread(i); });
+        
+        try {
+            // the default depth cutoff creates two cubes; split deep enough to keep all workers busy.
+            unsigned depth = std::max(m_config.m_lookahead_cube_depth, log2(4 * num_workers));
+            flet<unsigned> _depth(m_config.m_lookahead_cube_depth, depth);
+            lookahead lh(*this);
+            bool_var_vector vars;
+            literal_vector cube;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(mux);
+                    cv.wait(lock, [&] { return done || cubes.size() - head < 2 * num_workers; });
+                    if (done) 
+                        break;
+                }
+                vars.reset();
+                lbool r = lh.cube(vars, cube, UINT_MAX);
+                if (r == l_false) 
+                    break;
+                if (r == l_true) {
+                    // pass the lookahead model to a worker as a complete cube.
+                    cube.reset();
+                    model const& mdl = lh.get_model();
+                    for (bool_var v = 0; v < mdl.size() && v < num_vars; ++v) 
+                        if (value(v) == l_undef && !was_eliminated(v) && mdl[v] != l_undef)
+                            cube.push_back(literal(v, mdl[v] == l_false));
+                }
+                bool last = r == l_true || cube.empty();
+                {
+                    std::lock_guard<std::mutex> lock(mux);
+                    cubes.push_back(cube);
+                    ++num_cubes;
+                    cv.notify_all();
+                }
+                if (last) 
+                    break;
+            }
+        }
+        catch (z3_exception&) {
+            std::lock_guard<std::mutex> lock(mux);
+            finish(l_undef, -1);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mux);
+            generating = false;
+            cv.notify_all();
+        }
+        for (auto& th : threads) 
+            th.join();
+
+        IF_VERBOSE(1, verbose_stream() << "(sat.cube-and-conquer :cubes " << num_cubes << " :refuted " << num_refuted << " :units " << units.size() << ")\n";);
+        m_aux_stats.update("sat cubes", num_cubes);
+        m_aux_stats.update("sat cubes refuted", num_refuted);
+        m_aux_stats.update("sat cubes shared units", units.size());
+        if (winner != -1)
+            m_stats = workers[winner]->m_stats;
+        if (result == l_true) 
+            set_model(workers[winner]->get_model(), true);
+        if (!canceled) 
+            rlimit().reset_cancel();
+        return result;
+    }
+#endif
+
     /*
       \brief import lemmas/units from parallel sat solvers.
      */
@@ -2039,21 +2260,27 @@ namespace sat {
         m_cleaner(m_config.m_force_cleanup);
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_scc();
+        {
+            inprocess::scope _sc(m_inprocess, inprocess::scc_t);
+            m_scc();
+        }
         CASSERT("sat_simplify_bug", check_invariant());
 
         if (m_ext) {
             m_ext->pre_simplify();
         }
       
-        m_simplifier(false);
+        {
+            inprocess::scope _sc(m_inprocess, inprocess::simplifier_t);
+            m_simplifier(false);
 
-        CASSERT("sat_simplify_bug", check_invariant());
-        CASSERT("sat_missed_prop", check_missed_propagation());
-        if (!m_learned.empty()) {
-            m_simplifier(true);
-            CASSERT("sat_missed_prop", check_missed_propagation());
             CASSERT("sat_simplify_bug", check_invariant());
+            CASSERT("sat_missed_prop", check_missed_propagation());
+            if (!m_learned.empty()) {
+                m_simplifier(true);
+                CASSERT("sat_missed_prop", check_missed_propagation());
+                CASSERT("sat_simplify_bug", check_invariant());
+            }
         }
         sort_watch_lits();
         CASSERT("sat_simplify_bug", check_invariant());
@@ -2065,10 +2292,16 @@ namespace sat {
             m_ext->simplify();
         }
 
-        m_probing();
+        {
+            inprocess::scope _sc(m_inprocess, inprocess::probing_t);
+            m_probing();
+        }
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
-        m_asymm_branch(false);
+        {
+            inprocess::scope _sc(m_inprocess, inprocess::asymm_branch_t);
+            m_asymm_branch(false);
+        }
 
         if (m_config.m_lookahead_simplify && !m_ext) {
             lookahead lh(*this);
@@ -2107,9 +2340,12 @@ namespace sat {
         }
         
         if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay && !inconsistent()) {
+            inprocess::scope _sc(m_inprocess, inprocess::cut_simplifier_t);
             (*m_cut_simplifier)();
         }
 
+        m_inprocess.update_budgets();
+
         if (m_config.m_inprocess_out.is_non_empty_string()) {
             std::ofstream fout(m_config.m_inprocess_out.str());
             if (fout) {
@@ -2348,10 +2584,16 @@ namespace sat {
             }
             log_stats();
         }
-        TRACE("sat", tout << "restart " << restart_level(to_base) << "\n";);
         IF_VERBOSE(30, display_status(verbose_stream()););
-        TRACE("sat", tout << "restart " << restart_level(to_base) << "\n";);
-        pop_reinit(restart_level(to_base));
+        if (m_vivify_pending) {
+            TRACE("sat", tout << "restart with vivification\n";);
+            vivify_learned();
+        }
+        else {
+            unsigned num_scopes = restart_level(to_base);
+            TRACE("sat", tout << "restart " << num_scopes << "\n";);
+            pop_reinit(num_scopes);
+        }
         set_next_restart();        
     }
 
@@ -2375,11 +2617,13 @@ namespace sat {
             while (n < scope_lvl() - search_lvl());
             return n;
 #endif
-            // pop trail from bottom
+            // pop trail from bottom: 
+            // the decisions up to level n are more active than the next decision
+            // and would be made again after a full restart, so they are kept.
             unsigned n = search_lvl();
             for (; n < scope_lvl() && m_case_split_queue.more_active(scope_literal(n).var(), next); ++n) {
             }
-            return n - search_lvl();
+            return scope_lvl() - n;
         }
     }
 
@@ -3589,6 +3833,7 @@ namespace sat {
             m_probing.reset_cache(literal(w, false));
         }
         m_watches.shrink(2*v);
+        m_bin_prefix.shrink(2*v);
         m_assignment.shrink(2*v);
         m_justification.shrink(v);
         m_decision.shrink(v);
@@ -3753,6 +3998,7 @@ namespace sat {
         m_asymm_branch.updt_params(p);
         m_probing.updt_params(p);
         m_scc.updt_params(p);
+        m_inprocess.set_adaptive(m_config.m_inprocess_adaptive);
         m_rand.set_seed(m_config.m_random_seed);
         m_step_size = m_config.m_step_size_init;
         m_drat.updt_config();
@@ -3782,6 +4028,7 @@ namespace sat {
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
         m_probing.collect_statistics(st);
+        m_inprocess.collect_statistics(st);
         if (m_ext) m_ext->collect_statistics(st);
         if (m_local_search) m_local_search->collect_statistics(st);
         if (m_cut_simplifier) m_cut_simplifier->collect_statistics(st);
@@ -3794,6 +4041,7 @@ namespace sat {
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
         m_probing.reset_statistics();
+        m_inprocess.reset_statistics();
         m_aux_stats.reset();
     }
 
@@ -4762,6 +5010,10 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat parallel exported", m_par_exported);
+        st.update("sat parallel imported", m_par_imported);
+        st.update("sat parallel useful", m_par_useful);
+        st.update("sat defrag", m_defrag);
     }
 
     void stats::reset() {
@@ -41,6 +41,7 @@ Revision History:
 #include "sat/sat_asymm_branch.h"
 #include "sat/sat_cut_simplifier.h"
 #include "sat/sat_probing.h"
+#include "sat/sat_inprocess.h"
 #include "sat/sat_mus.h"
 #include "sat/sat_binspr.h"
 #include "sat/sat_drat.h"
@@ -79,6 +80,10 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_par_exported;
+        unsigned m_par_imported;
+        unsigned m_par_useful;
+        unsigned m_defrag;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -112,6 +117,7 @@ namespace sat {
         scc                     m_scc;
         asymm_branch            m_asymm_branch;
         probing                 m_probing;
+        inprocess               m_inprocess;
         bool                    m_is_probing { false };
         mus                     m_mus;           // MUS for minimal core extraction
         binspr                  m_binspr;
@@ -127,6 +133,7 @@ namespace sat {
         unsigned                m_num_frozen;
         unsigned_vector         m_active_vars, m_free_vars, m_vars_to_free, m_vars_to_reinit;
         vector<watch_list>      m_watches;
+        unsigned_vector         m_bin_prefix;   // size of the binary prefix of each watch list at the last insertion
         svector<lbool>          m_assignment;
         svector<justification>  m_justification; 
         bool_vector             m_decision;
@@ -239,6 +246,7 @@ namespace sat {
         friend class lut_finder;
         friend class npn3_finder;
         friend class proof_trim;
+        friend class inprocess;
         friend struct backoff;
     public:
         solver(params_ref const & p, reslimit& l);
@@ -550,6 +558,7 @@ namespace sat {
         double   m_simplify_mult = 1.5;
         bool     m_simplify_enabled = true;
         bool     m_restart_enabled = true;
+        bool     m_vivify_pending = false;
         bool guess(bool_var next);
         bool decide();
         bool_var next_var();
@@ -590,6 +599,7 @@ namespace sat {
         void sort_watch_lits();
         void exchange_par();
         lbool check_par(unsigned num_lits, literal const* lits);
+        lbool check_cube_and_conquer();
         lbool do_local_search(unsigned num_lits, literal const* lits);
         lbool do_ddfw_search(unsigned num_lits, literal const* lits);
         lbool do_prob_search(unsigned num_lits, literal const* lits);
@@ -613,6 +623,7 @@ namespace sat {
         void save_psm();
         void gc_half(char const * st_name);
         void gc_dyn_psm();
+        void vivify_learned();
         bool activate_frozen_clause(clause & c);
         unsigned psm(clause const & c) const;
         bool can_delete(clause const & c) const;
@@ -40,6 +40,22 @@ namespace sat {
         return false;                                           
     }
 
+    void insert_binary_watch(watch_list & wlist, watched const& w, unsigned& prefix) {
+        SASSERT(w.is_binary_clause());
+        unsigned sz = wlist.size();
+        wlist.push_back(w);
+        if (prefix > sz || 
+            (prefix > 0 && !wlist[prefix - 1].is_binary_clause()) || 
+            (prefix < sz && wlist[prefix].is_binary_clause())) {
+            prefix = 0;
+            while (prefix < sz && wlist[prefix].is_binary_clause())
+                ++prefix;
+        }
+        if (prefix < sz)
+            std::swap(wlist[prefix], wlist[sz]);
+        ++prefix;
+    }
+
     watched* find_binary_watch(watch_list & wlist, literal l) {
         for (watched& w : wlist) {
             if (w.is_binary_clause() && w.get_literal() == l) return &w;
@@ -117,6 +117,15 @@ namespace sat {
 
     typedef vector<watched> watch_list;
 
+    /**
+       \brief Add a binary watch to wlist, keeping binary watches ahead of clause and 
+       external constraint watches. Propagation visits this prefix first, but remains
+       correct if the order is broken by other updates to the watch list.
+       prefix is the size of the binary prefix from the last insertion. It is
+       recomputed only if the boundary it points to was moved by other updates.
+    */
+    void insert_binary_watch(watch_list & wlist, watched const& w, unsigned& prefix);
+
     watched* find_binary_watch(watch_list & wlist, literal l);
     watched const* find_binary_watch(watch_list const & wlist, literal l);
     bool erase_clause_watch(watch_list & wlist, clause_offset c);
@@ -21,6 +21,7 @@ Revision History:
 #include<signal.h>
 #include "util/timeout.h"
 #include "util/rlimit.h"
+#include "util/stopwatch.h"
 #include "util/gparams.h"
 #include "sat/dimacs.h"
 #include "sat/sat_params.hpp"
@@ -232,6 +233,8 @@ unsigned read_dimacs(char const * file_name) {
     sat::solver solver(p, limit);
     g_solver = &solver;
 
+    stopwatch load_time;
+    load_time.start();
     if (file_name) {
         std::ifstream in(file_name);
         if (in.bad() || in.fail()) {
@@ -243,6 +246,9 @@ unsigned read_dimacs(char const * file_name) {
     else {
         parse_dimacs(std::cin, std::cerr, solver);
     }
+    load_time.stop();
+    g_st.update("load time", load_time.get_seconds());
+    g_st.update("load max memory", static_cast<double>((100*memory::get_max_used_memory())/(1024*1024))/100.0);
     IF_VERBOSE(20, solver.display_status(verbose_stream()););
     
     lbool r;
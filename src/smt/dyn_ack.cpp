@@ -165,12 +165,17 @@ namespace smt {
     dyn_ack_manager::dyn_ack_manager(context & ctx, dyn_ack_params & p):
         m_context(ctx),
         m(ctx.get_manager()),
-        m_params(p) {
+        m_params(p),
+        m_cache_head(UINT_MAX),
+        m_cache_tail(UINT_MAX),
+        m_num_cached_instances(0),
+        m_backtracking(false) {
     }
 
     dyn_ack_manager::~dyn_ack_manager() {
         reset_app_pairs();
         reset_app_triples();
+        reset_cache();
     }
 
     void dyn_ack_manager::reset_app_pairs() {
@@ -194,6 +199,140 @@ namespace smt {
         reset_app_triples();
         m_triple.m_to_instantiate.reset();
         m_triple.m_qhead = 0;
+
+        instantiate_cached();
+    }
+
+    void dyn_ack_manager::cache_lemma(app * n1, app * n2, app * r) {
+        if (m_params.m_dack_cache_size == 0 || !m_backtracking)
+            return;
+        unsigned idx;
+        if (r ? m_triple2cache.find(n1, n2, r, idx) : m_pair2cache.find(n1, n2, idx)) {
+            m_cache[idx].m_score++;
+            cache_unlink(idx);
+            cache_link(idx);
+            return;
+        }
+        if (m_cache.size() - m_cache_free.size() >= m_params.m_dack_cache_size) 
+            uncache(m_cache_tail);
+        m.inc_ref(n1);
+        m.inc_ref(n2);
+        if (r)
+            m.inc_ref(r);
+        if (m_cache_free.empty()) {
+            idx = m_cache.size();
+            m_cache.push_back(cached_lemma());
+        }
+        else {
+            idx = m_cache_free.back();
+            m_cache_free.pop_back();
+        }
+        m_cache[idx] = { n1, n2, r, 1, UINT_MAX, UINT_MAX };
+        cache_link(idx);
+        if (r)
+            m_triple2cache.insert(n1, n2, r, idx);
+        else
+            m_pair2cache.insert(n1, n2, idx);
+    }
+
+    void dyn_ack_manager::cache_link(unsigned idx) {
+        cached_lemma & c = m_cache[idx];
+        c.m_prev = UINT_MAX;
+        c.m_next = m_cache_head;
+        if (m_cache_head != UINT_MAX)
+            m_cache[m_cache_head].m_prev = idx;
+        else
+            m_cache_tail = idx;
+        m_cache_head = idx;
+    }
+
+    void dyn_ack_manager::cache_unlink(unsigned idx) {
+        cached_lemma & c = m_cache[idx];
+        if (c.m_prev != UINT_MAX)
+            m_cache[c.m_prev].m_next = c.m_next;
+        else
+            m_cache_head = c.m_next;
+        if (c.m_next != UINT_MAX)
+            m_cache[c.m_next].m_prev = c.m_prev;
+        else
+            m_cache_tail = c.m_prev;
+    }
+
+    void dyn_ack_manager::uncache(unsigned idx) {
+        cached_lemma c = m_cache[idx];
+        if (c.m_r)
+            m_triple2cache.erase(c.m_app1, c.m_app2, c.m_r);
+        else
+            m_pair2cache.erase(c.m_app1, c.m_app2);
+        cache_unlink(idx);
+        m_cache_free.push_back(idx);
+        m.dec_ref(c.m_app1);
+        m.dec_ref(c.m_app2);
+        if (c.m_r)
+            m.dec_ref(c.m_r);
+    }
+
+    void dyn_ack_manager::reset_cache() {
+        for (unsigned idx = m_cache_head; idx != UINT_MAX; idx = m_cache[idx].m_next) {
+            cached_lemma const & c = m_cache[idx];
+            m.dec_ref(c.m_app1);
+            m.dec_ref(c.m_app2);
+            if (c.m_r)
+                m.dec_ref(c.m_r);
+        }
+        m_cache.reset();
+        m_cache_free.reset();
+        m_cache_head = m_cache_tail = UINT_MAX;
+        m_pair2cache.reset();
+        m_triple2cache.reset();
+    }
+
+    /**
+       \brief Queue the cached lemmas whose terms are internalized. They are
+       instantiated by propagate_eh in addition to the lemmas allowed by dack.factor.
+    */
+    void dyn_ack_manager::instantiate_cached() {
+        m_num_cached_instances = 0;
+        if (m_params.m_dack == dyn_ack_strategy::DACK_DISABLED || m_cache_head == UINT_MAX)
+            return;
+        // lemmas with the same score are queued most recently used first.
+        svector<cached_lemma> lemmas;
+        for (unsigned idx = m_cache_head; idx != UINT_MAX; idx = m_cache[idx].m_next)
+            lemmas.push_back(m_cache[idx]);
+        std::stable_sort(lemmas.begin(), lemmas.end(), [](cached_lemma const & a, cached_lemma const & b) { return a.m_score > b.m_score; });
+        for (cached_lemma const & c : lemmas) {
+            app * n1 = c.m_app1, * n2 = c.m_app2, * r = c.m_r;
+            if (!m_context.e_internalized(n1) || !m_context.e_internalized(n2) || (r && !m_context.e_internalized(r)))
+                continue;
+            m.inc_ref(n1);
+            m.inc_ref(n2);
+            if (r) {
+                app_triple tr(n1, n2, r);
+                if (m_triple.m_instantiated.contains(tr) || m_triple.m_app2num_occs.contains(n1, n2, r)) {
+                    m.dec_ref(n1);
+                    m.dec_ref(n2);
+                    continue;
+                }
+                m.inc_ref(r);
+                m_triple.m_apps.push_back(tr);
+                m_triple.m_app2num_occs.insert(n1, n2, r, m_params.m_dack_threshold);
+                m_triple.m_to_instantiate.push_back(tr);
+            }
+            else {
+                app_pair p(n1, n2);
+                if (m_instantiated.contains(p) || m_app_pair2num_occs.contains(n1, n2)) {
+                    m.dec_ref(n1);
+                    m.dec_ref(n2);
+                    continue;
+                }
+                m_app_pairs.push_back(p);
+                m_app_pair2num_occs.insert(n1, n2, m_params.m_dack_threshold);
+                m_to_instantiate.push_back(p);
+            }
+            m_num_cached_instances++;
+        }
+        m_context.m_stats.m_num_cached_dyn_ack += m_num_cached_instances;
+        TRACE("dyn_ack", tout << "cached lemmas: " << m_num_cached_instances << "\n";);
     }
 
     void dyn_ack_manager::cg_eh(app * n1, app * n2) {
@@ -359,6 +498,7 @@ namespace smt {
             SASSERT(p.first && p.second);
             m_instantiated.erase(p);
             m_clause2app_pair.erase(cls);
+            cache_lemma(p.first, p.second, nullptr);
             SASSERT(!m_app_pair2num_occs.contains(p.first, p.second));
             return;
         }
@@ -367,6 +507,7 @@ namespace smt {
             SASSERT(tr.first && tr.second && tr.third);
             m_triple.m_instantiated.erase(tr);
             m_triple.m_clause2apps.erase(cls);
+            cache_lemma(tr.first, tr.second, tr.third);
             SASSERT(!m_triple.m_app2num_occs.contains(tr.first, tr.second, tr.third));
             return;
         }
@@ -380,7 +521,7 @@ namespace smt {
             gc();
             m_num_propagations_since_last_gc = 0;
         }
-        unsigned max_instances  = static_cast<unsigned>(m_context.get_num_conflicts() * m_params.m_dack_factor);
+        unsigned max_instances  = static_cast<unsigned>(m_context.get_num_conflicts() * m_params.m_dack_factor) + m_num_cached_instances;
         while (m_num_instances < max_instances && m_qhead < m_to_instantiate.size()) {
             app_pair & p = m_to_instantiate[m_qhead];
             m_qhead++;
@@ -441,6 +582,7 @@ namespace smt {
     }
 
     void dyn_ack_manager::reset() {
+        reset_cache();
         init_search_eh();
         m_instantiated.reset();
         m_clause2app_pair.reset();
@@ -65,8 +65,37 @@ namespace smt {
             clause2app_triple                      m_clause2apps;
         };
         _triple                                    m_triple;
-        
 
+        /**
+           Ackermann lemmas whose clauses were deleted by backtracking.
+           The lemmas whose terms are still internalized are instantiated
+           again at the beginning of the next search, most useful first.
+           Cached lemmas form a list in least recently used order, the
+           tail is evicted when the cache is full.
+        */
+        struct cached_lemma {
+            app *    m_app1;
+            app *    m_app2;
+            app *    m_r;       // nullptr for congruence lemmas
+            unsigned m_score;   // number of times the lemma was learned
+            unsigned m_prev;    // more recently used lemma
+            unsigned m_next;    // less recently used lemma
+        };
+        svector<cached_lemma>                      m_cache;
+        unsigned_vector                            m_cache_free;  // unused entries of m_cache
+        unsigned                                   m_cache_head;  // most recently used lemma
+        unsigned                                   m_cache_tail;  // least recently used lemma
+        obj_pair_map<app, app, unsigned>           m_pair2cache;
+        obj_triple_map<app, app, app, unsigned>    m_triple2cache;
+        unsigned                                   m_num_cached_instances;
+        bool                                       m_backtracking;
+
+        void cache_lemma(app * n1, app * n2, app * r);
+        void cache_link(unsigned idx);
+        void cache_unlink(unsigned idx);
+        void uncache(unsigned idx);
+        void reset_cache();
+        void instantiate_cached();
 
         void gc();
         void reset_app_pairs();
@@ -125,6 +154,18 @@ namespace smt {
 
         void reset();
 
+        /**
+           \brief Lemmas are cached only when their clauses are deleted while backtracking.
+           Clauses deleted by garbage collection are not cached.
+        */
+        class scoped_backtrack {
+            dyn_ack_manager & m_dack;
+            bool              m_old;
+        public:
+            scoped_backtrack(dyn_ack_manager & d): m_dack(d), m_old(d.m_backtracking) { d.m_backtracking = true; }
+            ~scoped_backtrack() { m_dack.m_backtracking = m_old; }
+        };
+
 #ifdef Z3DEBUG
         bool check_invariant() const;
 #endif
@@ -19,6 +19,7 @@ Revision History:
 #include <algorithm>
 
 #include "util/pool.h"
+#include "util/scoped_ptr_vector.h"
 #include "util/trail.h"
 #include "util/stopwatch.h"
 #include "ast/ast_pp.h"
@@ -26,6 +27,11 @@ Revision History:
 #include "ast/ast_smt2_pp.h"
 #include "smt/mam.h"
 #include "smt/smt_context.h"
+#ifndef SINGLE_THREAD
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
 
 using namespace smt;
 
@@ -1833,6 +1839,26 @@ namespace {
 
     typedef svector<backtrack_point> backtrack_stack;
 
+    /**
+       \brief Matches found by an interpreter that runs in a matching thread.
+       They are added to the context by the main thread.
+    */
+    struct match_buffer {
+        struct match {
+            quantifier * m_qa;
+            app *        m_pat;
+            unsigned     m_num_bindings;
+            unsigned     m_bindings_offset;
+            unsigned     m_max_generation;
+            unsigned     m_min_top_generation;
+            unsigned     m_max_top_generation;
+        };
+        svector<match> m_matches;
+        enode_vector   m_bindings;
+        bool           m_done = false;
+        void reset() { m_matches.reset(); m_bindings.reset(); m_done = false; }
+    };
+
     class interpreter {
         context &           m_context;
         ast_manager &       m;
@@ -1864,6 +1890,26 @@ namespace {
 
         pool<enode_vector>  m_pool;
 
+        // When m_buffer is set, the interpreter runs in a matching thread: it only reads
+        // the e-graph and the matches are stored in m_buffer.
+        match_buffer *      m_buffer = nullptr;
+        tmp_enode           m_tmp_enode;
+        ptr_addr_hashtable<enode> m_visited;
+
+        bool canceled() {
+            return m_buffer ? m.limit().is_canceled() : m_context.get_cancel_flag();
+        }
+
+        bool limits_exceeded() {
+            return m_buffer ? m.limit().is_canceled() : m_context.resource_limits_exceeded();
+        }
+
+        enode * get_enode_eq_to(func_decl * f, unsigned num_args, enode * const * args) {
+            return m_buffer ? m_context.find_enode_eq_to(m_tmp_enode, f, num_args, args) : m_context.get_enode_eq_to(f, num_args, args);
+        }
+
+        void on_match(quantifier * qa, app * pat, unsigned num_bindings, enode * const * bindings);
+
         enode_vector * mk_enode_vector() {
             enode_vector * r = m_pool.mk();
             r->reset();
@@ -2006,15 +2052,29 @@ namespace {
                 m_backtrack_stack.resize(t->get_num_choices());
         }
 
+        void set_buffer(match_buffer * b) { m_buffer = b; }
+
         bool execute(code_tree * t) {
             TRACE("trigger_bug", tout << "execute for code tree:\n"; t->display(tout););
             init(t);
+            if (m_buffer && t->filter_candidates()) {
+                // enode marks are shared with the other matching threads.
+                m_visited.reset();
+                for (enode* app : t->get_candidates()) {
+                    if (!m_visited.contains(app) && app->is_cgr()) {
+                        if (limits_exceeded() || !execute_core(t, app))
+                            return false;
+                        m_visited.insert(app);
+                    }
+                }
+                return true;
+            }
 #define CLEANUP  for (enode* app : t->get_candidates()) if (app->is_marked()) app->unset_mark();
             if (t->filter_candidates()) {
                 for (enode* app : t->get_candidates()) {
                     TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
                     if (!app->is_marked() && app->is_cgr()) {
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app)) {
+                        if (limits_exceeded() || !execute_core(t, app)) {
                             CLEANUP;
                             return false;
                         }
@@ -2030,7 +2090,7 @@ namespace {
                     if (app->is_cgr()) {
                         TRACE("trigger_bug", tout << "is_cgr\n";);
                         // scoped_suspend_rlimit susp(m.limit(), false);
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                        if (limits_exceeded() || !execute_core(t, app))
                             return false;
                     }
                 }
@@ -2064,6 +2124,22 @@ namespace {
         }
     };
 
+    void interpreter::on_match(quantifier * qa, app * pat, unsigned num_bindings, enode * const * bindings) {
+        if (!m_buffer) {
+            m_mam.on_match(qa, pat, num_bindings, bindings, m_max_generation, m_used_enodes);
+            return;
+        }
+        match_buffer::match mt;
+        mt.m_qa              = qa;
+        mt.m_pat             = pat;
+        mt.m_num_bindings    = num_bindings;
+        mt.m_bindings_offset = m_buffer->m_bindings.size();
+        mt.m_max_generation  = m_max_generation;
+        get_min_max_top_generation(mt.m_min_top_generation, mt.m_max_top_generation);
+        m_buffer->m_bindings.append(num_bindings, bindings);
+        m_buffer->m_matches.push_back(mt);
+    }
+
     /**
        \brief Return a vector with the relevant f-parents of n such that n is the i-th argument.
     */
@@ -2537,14 +2613,13 @@ namespace {
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
 #define ON_MATCH(NUM)                                                   \
             m_max_generation = std::max(m_max_generation, get_max_generation(NUM, m_bindings.begin())); \
-            if (m_context.get_cancel_flag()) {                          \
+            if (canceled()) {                                           \
                 return false;                                           \
             }                                                           \
-            m_mam.on_match(static_cast<const yield *>(m_pc)->m_qa,                                      \
-                           static_cast<const yield *>(m_pc)->m_pat,                                     \
-                           NUM,                                                                         \
-                           m_bindings.begin(),                                                          \
-                           m_max_generation, m_used_enodes)
+            on_match(static_cast<const yield *>(m_pc)->m_qa,                                            \
+                     static_cast<const yield *>(m_pc)->m_pat,                                           \
+                     NUM,                                                                               \
+                     m_bindings.begin())
             ON_MATCH(1);
             goto backtrack;
 
@@ -2602,7 +2677,7 @@ namespace {
 
         case GET_CGR1:
 #define GET_CGR_COMMON()                                                                                                                                                \
-            m_n1 = m_context.get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());              \
+            m_n1 = get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());                        \
             if (m_n1 == 0 || !m_context.is_relevant(m_n1))                                                                                                              \
                 goto backtrack;                                                                                                                                         \
             update_max_generation(m_n1, nullptr);                                                                                                                       \
@@ -2713,7 +2788,7 @@ namespace {
 
         if (since_last_check++ > 100) {
             since_last_check = 0;
-            if (m_context.resource_limits_exceeded()) {
+            if (limits_exceeded()) {
                 // Soft timeout...
                 // Cleanup before exiting
                 while (m_top != 0) {
@@ -3097,6 +3172,9 @@ namespace {
         compiler                    m_compiler;
         interpreter                 m_interpreter;
         code_tree_map               m_trees;
+        scoped_ptr_vector<interpreter> m_workers;  // interpreters used by matching threads
+        vector<match_buffer>        m_buffers;
+        vector<std::tuple<enode *, enode *>> m_no_used_enodes;
 
         ptr_vector<code_tree>       m_tmp_trees;
         ptr_vector<func_decl>       m_tmp_trees_to_delete;
@@ -3888,13 +3966,102 @@ namespace {
             }
         }
 
+        bool use_match_threads() const {
+#ifdef SINGLE_THREAD
+            return false;
+#else
+            if (m_context.get_fparams().m_qi_match_threads <= 1 || m_to_match.size() <= 1)
+                return false;
+            // the used enodes are only collected by the sequential interpreter.
+            if (m.has_trace_stream() || is_trace_enabled("causality"))
+                return false;
+            unsigned num_candidates = 0;
+            for (code_tree* t : m_to_match)
+                num_candidates += t->get_candidates().size();
+            return num_candidates >= 128;
+#endif
+        }
+
+        /**
+           \brief Match the code trees in m_to_match using several threads.
+           The threads do not update the e-graph. Matches are buffered per code tree and
+           added to the context in the order of m_to_match, so the instances are the same as
+           when the code trees are matched sequentially.
+        */
+        bool match_parallel() {
+#ifdef SINGLE_THREAD
+            return false;
+#else
+            unsigned num_trees   = m_to_match.size();
+            unsigned num_threads = std::min(m_context.get_fparams().m_qi_match_threads, num_trees);
+            while (m_workers.size() < num_threads)
+                m_workers.push_back(alloc(interpreter, m_context, *this, m_use_filters));
+            m_buffers.reserve(num_trees);
+            for (unsigned i = 0; i < num_trees; ++i)
+                m_buffers[i].reset();
+
+            std::atomic<unsigned> next(0);
+            std::mutex mux;
+            bool has_ex = false;
+            std::string ex_msg;
+            auto worker_thread = [&](interpreter & w) {
+                try {
+                    for (unsigned i = next++; i < num_trees; i = next++) {
+                        match_buffer & b = m_buffers[i];
+                        w.set_buffer(&b);
+                        b.m_done = w.execute(m_to_match[i]);
+                        if (!b.m_done) {
+                            next = num_trees;
+                            break;
+                        }
+                    }
+                }
+                catch (z3_exception & ex) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    has_ex = true;
+                    ex_msg = ex.msg();
+                    next = num_trees;
+                }
+                w.set_buffer(nullptr);
+            };
+            vector<std::thread> threads;
+            for (unsigned k = 1; k < num_threads; ++k)
+                threads.push_back(std::thread([&, k]() { worker_thread(*m_workers[k]); }));
+            worker_thread(*m_workers[0]);
+            for (auto & th : threads)
+                th.join();
+            if (has_ex)
+                throw default_exception(std::move(ex_msg));
+
+            for (unsigned i = 0; i < num_trees; ++i) {
+                match_buffer & b = m_buffers[i];
+                for (auto const& mt : b.m_matches)
+                    m_context.add_instance(mt.m_qa, mt.m_pat, mt.m_num_bindings, b.m_bindings.data() + mt.m_bindings_offset, nullptr,
+                                           mt.m_max_generation, mt.m_min_top_generation, mt.m_max_top_generation, m_no_used_enodes);
+                if (!b.m_done) {
+                    // record the reason for stopping, as the sequential interpreter does.
+                    m_context.resource_limits_exceeded();
+                    return false;
+                }
+                m_to_match[i]->reset_candidates();
+            }
+            return true;
+#endif
+        }
+
         void match() override {
             TRACE("trigger_bug", tout << "match\n"; display(tout););
-            for (code_tree* t : m_to_match) {
-                SASSERT(t->has_candidates());
-                if (!m_interpreter.execute(t))
+            if (use_match_threads()) {
+                if (!match_parallel())
                     return;
-                t->reset_candidates();
+            }
+            else {
+                for (code_tree* t : m_to_match) {
+                    SASSERT(t->has_candidates());
+                    if (!m_interpreter.execute(t))
+                        return;
+                    t->reset_candidates();
+                }
             }
             m_to_match.reset();
             if (!m_new_patterns.empty()) {
@@ -27,6 +27,7 @@ void dyn_ack_params::updt_params(params_ref const & _p) {
     m_dack_threshold = p.dack_threshold();
     m_dack_gc = p.dack_gc();
     m_dack_gc_inv_decay = p.dack_gc_inv_decay();
+    m_dack_cache_size = p.dack_cache_size();
 }
 
 #define DISPLAY_PARAM(X) out << #X"=" << X << '\n';
@@ -38,4 +39,5 @@ void dyn_ack_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_dack_threshold);
     DISPLAY_PARAM(m_dack_gc);
     DISPLAY_PARAM(m_dack_gc_inv_decay);
+    DISPLAY_PARAM(m_dack_cache_size);
 }
\ No newline at end of file
@@ -37,6 +37,8 @@ void qi_params::updt_params(params_ref const & _p) {
     m_qi_cost = p.qi_cost();
     m_qi_max_eager_multipatterns = p.qi_max_multi_patterns();
     m_qi_quick_checker = static_cast<quick_checker_mode>(p.qi_quick_checker());
+    m_qi_match_threads = p.qi_match_threads();
+    m_qi_loop_limit = p.qi_loop_limit();
 }
 
 #define DISPLAY_PARAM(X) out << #X"=" << X << '\n';
@@ -56,6 +58,8 @@ void qi_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_qi_max_instances);
     DISPLAY_PARAM(m_qi_lazy_instantiation);
     DISPLAY_PARAM(m_qi_conservative_final_check);
+    DISPLAY_PARAM(m_qi_match_threads);
+    DISPLAY_PARAM(m_qi_loop_limit);
     DISPLAY_PARAM(m_mbqi);
     DISPLAY_PARAM(m_mbqi_max_cexs);
     DISPLAY_PARAM(m_mbqi_max_cexs_incr);
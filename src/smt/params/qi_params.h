@@ -42,6 +42,8 @@ struct qi_params {
     unsigned           m_qi_max_instances = UINT_MAX;
     bool               m_qi_lazy_instantiation = false;
     bool               m_qi_conservative_final_check = false;
+    unsigned           m_qi_match_threads = 1;
+    unsigned           m_qi_loop_limit = 0;
     bool               m_qe_lite = false;
 
     bool               m_mbqi = true;
@@ -37,6 +37,9 @@ void smt_params::updt_local_params(params_ref const & _p) {
     if (m_restart_strategy > RS_ARITHMETIC) throw default_exception("illegal restart strategy numeral");
     m_restart_factor = p.restart_factor();
     m_case_split_strategy = static_cast<case_split_strategy>(p.case_split());
+    if (m_case_split_strategy > CS_ACTIVITY_LRB) throw default_exception("illegal case split strategy numeral");
+    m_branching_theory_weight = p.branching_theory_weight();
+    m_branching_switch_interval = p.branching_switch_interval();
     m_theory_case_split = p.theory_case_split();
     m_theory_aware_branching = p.theory_aware_branching();
     m_delay_units = p.delay_units();
@@ -48,6 +51,8 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
+    m_threads_share_size = p.threads_share_size();
+    m_threads_cube_and_conquer = p.threads_cube_and_conquer();
     m_core_validate = p.core_validate();
     m_sls_enable = p.sls_enable();
     m_logic = _p.get_sym("logic", m_logic);
@@ -123,6 +128,8 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_threads);
     DISPLAY_PARAM(m_threads_max_conflicts);
     DISPLAY_PARAM(m_threads_cube_frequency);
+    DISPLAY_PARAM(m_threads_share_size);
+    DISPLAY_PARAM(m_threads_cube_and_conquer);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
@@ -134,6 +141,8 @@ void smt_params::display(std::ostream & out) const {
 
     DISPLAY_PARAM(m_case_split_strategy);
     DISPLAY_PARAM(m_rel_case_split_order);
+    DISPLAY_PARAM(m_branching_theory_weight);
+    DISPLAY_PARAM(m_branching_switch_interval);
     DISPLAY_PARAM(m_lookahead_diseq);
 
     DISPLAY_PARAM(m_delay_units);
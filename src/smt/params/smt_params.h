@@ -70,7 +70,10 @@ enum case_split_strategy {
     CS_RELEVANCY, // case split based on relevancy
     CS_RELEVANCY_ACTIVITY, // case split based on relevancy and activity
     CS_RELEVANCY_GOAL, // based on relevancy and the current goal
-    CS_ACTIVITY_THEORY_AWARE_BRANCHING // activity-based case split, but theory solvers can manipulate activity
+    CS_ACTIVITY_THEORY_AWARE_BRANCHING, // activity-based case split, but theory solvers can manipulate activity
+    CS_CHB, // conflict history based branching
+    CS_LRB, // learning rate based branching
+    CS_ACTIVITY_LRB // switch between activity and learning rate based branching based on the conflict rate
 };
 
 struct smt_params : public preprocessor_params,
@@ -106,6 +109,8 @@ struct smt_params : public preprocessor_params,
     unsigned         m_threads = 1;
     unsigned         m_threads_max_conflicts = UINT_MAX;
     unsigned         m_threads_cube_frequency = 2;
+    unsigned         m_threads_share_size = 3;
+    bool             m_threads_cube_and_conquer = false;
     bool             m_simplify_clauses = true;
     unsigned         m_tick = 1000;
     bool             m_display_features = false;
@@ -126,6 +131,8 @@ struct smt_params : public preprocessor_params,
     bool                m_lookahead_diseq = false;
     bool                m_theory_case_split = false;
     bool                m_theory_aware_branching = false;
+    double              m_branching_theory_weight = 1.0;
+    unsigned            m_branching_switch_interval = 5000;
 
     // -----------------------------------
     //
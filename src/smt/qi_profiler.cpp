@@ -0,0 +1,149 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_profiler.cpp
+
+Abstract:
+
+    Profiler for quantifier instantiation.
+
+--*/
+
+#include "util/util.h"
+#include "smt/qi_profiler.h"
+
+namespace smt {
+
+    void qi_profiler::setup(bool report, bool track) {
+        m_report = report;
+        m_enabled = report || track;
+    }
+
+    unsigned qi_profiler::get_index(quantifier * q) {
+        unsigned idx;
+        if (m_index.find(q, idx))
+            return idx;
+        idx = m_profiles.size();
+        m_index.insert(q, idx);
+        m_pinned.push_back(q);
+        m_profiles.push_back(qprofile());
+        m_profiles.back().m_q = q;
+        return idx;
+    }
+
+    qi_profiler::producer const * qi_profiler::get_producer(enode * n) const {
+        unsigned id = n->get_expr_id();
+        if (id < m_producers.size() && m_producers[id].m_qidx != UINT_MAX)
+            return &m_producers[id];
+        return nullptr;
+    }
+
+    unsigned qi_profiler::loop_depth(quantifier * q, unsigned num_bindings, enode * const * bindings) const {
+        unsigned idx;
+        if (!m_enabled || !m_index.find(q, idx))
+            return 0;
+        unsigned depth = 0;
+        for (unsigned i = 0; i < num_bindings; ++i) {
+            producer const * p = get_producer(bindings[i]);
+            if (p && p->m_qidx == idx)
+                depth = std::max(depth, p->m_loop_depth + 1);
+        }
+        return depth;
+    }
+
+    void qi_profiler::add_instance(quantifier * q, unsigned generation, unsigned loop_depth, unsigned num_bindings, enode * const * bindings) {
+        if (!m_enabled)
+            return;
+        qprofile & p = m_profiles[get_index(q)];
+        p.m_instances++;
+        p.m_generations[std::min(generation, num_generations - 1)]++;
+        p.m_max_loop_depth = std::max(p.m_max_loop_depth, loop_depth);
+        for (unsigned i = 0; i < num_bindings; ++i)
+            if (producer const * src = get_producer(bindings[i]))
+                p.m_sources.insert_if_not_there(src->m_qidx, 0)++;
+    }
+
+    void qi_profiler::add_terms(quantifier * q, unsigned loop_depth, unsigned num_terms, enode * const * terms) {
+        if (!m_enabled)
+            return;
+        unsigned idx = get_index(q);
+        for (unsigned i = 0; i < num_terms; ++i) {
+            unsigned id = terms[i]->get_expr_id();
+            m_producers.reserve(id + 1);
+            if (m_producers[id].m_qidx != UINT_MAX)
+                continue;
+            m_producers[id].m_qidx = idx;
+            m_producers[id].m_loop_depth = loop_depth;
+            m_producer_trail.push_back(id);
+        }
+    }
+
+    void qi_profiler::add_throttled(quantifier * q) {
+        m_profiles[get_index(q)].m_throttled++;
+        m_num_throttled++;
+    }
+
+    void qi_profiler::push_scope() {
+        m_producer_lim.push_back(m_producer_trail.size());
+    }
+
+    void qi_profiler::pop_scope(unsigned num_scopes) {
+        unsigned lim = m_producer_lim[m_producer_lim.size() - num_scopes];
+        for (unsigned i = lim; i < m_producer_trail.size(); ++i)
+            m_producers[m_producer_trail[i]] = producer();
+        m_producer_trail.shrink(lim);
+        m_producer_lim.shrink(m_producer_lim.size() - num_scopes);
+    }
+
+    void qi_profiler::reset() {
+        flush();
+        m_index.reset();
+        m_pinned.reset();
+        m_profiles.reset();
+        m_producers.reset();
+        m_producer_trail.reset();
+        m_producer_lim.reset();
+    }
+
+    void qi_profiler::display(std::ostream & out, qprofile const & p) const {
+        double secs = m_watch.get_seconds();
+        out << "(qi-profile :qid " << p.m_q->get_qid()
+            << " :instances " << p.m_instances
+            << " :rate " << (secs > 0 ? p.m_instances / secs : 0.0)
+            << " :throttled " << p.m_throttled
+            << " :max-loop-depth " << p.m_max_loop_depth
+            << " :generations (";
+        for (unsigned g = 0; g < num_generations; ++g)
+            out << (g > 0 ? " " : "") << p.m_generations[g];
+        out << ") :sources (";
+        bool first = true;
+        for (auto const & kv : p.m_sources) {
+            out << (first ? "" : " ") << "(" << m_profiles[kv.m_key].m_q->get_qid() << " " << kv.m_value << ")";
+            first = false;
+        }
+        out << "))\n";
+    }
+
+    void qi_profiler::flush() {
+        if (!m_report)
+            return;
+        for (qprofile & p : m_profiles) {
+            if (p.m_reported == p.m_instances + p.m_throttled)
+                continue;
+            p.m_reported = p.m_instances + p.m_throttled;
+            display(verbose_stream(), p);
+        }
+        verbose_stream().flush();
+    }
+
+    void qi_profiler::display(std::ostream & out) const {
+        for (qprofile const & p : m_profiles)
+            display(out, p);
+    }
+
+    void qi_profiler::collect_statistics(::statistics & st) const {
+        st.update("throttled quant instantiations", m_num_throttled);
+    }
+};
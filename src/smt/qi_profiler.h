@@ -0,0 +1,108 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_profiler.h
+
+Abstract:
+
+    Profiler for quantifier instantiation.
+
+    For each quantifier the profiler tracks the number of instances,
+    the instance rate and a histogram of instance generations. It also
+    maintains the instantiation graph: an edge q1 -> q2 is counted when
+    an instance of q2 uses a binding that was created by an instance of q1.
+
+    The loop depth of an instance of q is the length of the longest chain
+    of instances of q that produced its bindings. It is used to detect and
+    throttle matching loops.
+
+    With smt.qi.profile the profile is written as s-expressions, one per
+    line, to the verbose stream. Quantifiers whose profile changed are
+    written at every final check.
+
+--*/
+#pragma once
+
+#include "util/map.h"
+#include "util/obj_hashtable.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include "smt/smt_enode.h"
+
+namespace smt {
+
+    class qi_profiler {
+        static const unsigned num_generations = 16; // last bucket collects larger generations
+        struct qprofile {
+            quantifier *    m_q = nullptr;
+            unsigned        m_instances = 0;
+            unsigned        m_throttled = 0;
+            unsigned        m_max_loop_depth = 0;
+            unsigned        m_reported = 0;
+            unsigned        m_generations[num_generations] = {};
+            u_map<unsigned> m_sources;      // index of source quantifier -> number of edges
+        };
+        struct producer {
+            unsigned m_qidx = UINT_MAX;
+            unsigned m_loop_depth = 0;
+        };
+        ast_manager &                 m;
+        bool                          m_enabled = false;
+        bool                          m_report = false;
+        obj_map<quantifier, unsigned> m_index;
+        expr_ref_vector               m_pinned;
+        vector<qprofile>              m_profiles;
+        svector<producer>             m_producers;  // producers of terms indexed by expression id
+        unsigned_vector               m_producer_trail;
+        unsigned_vector               m_producer_lim;
+        stopwatch                     m_watch;
+        unsigned                      m_num_throttled = 0;
+
+        unsigned get_index(quantifier * q);
+        producer const * get_producer(enode * n) const;
+        void display(std::ostream & out, qprofile const & p) const;
+
+    public:
+        qi_profiler(ast_manager & m): m(m), m_pinned(m) {}
+
+        /**
+           \brief enable producer tracking. The profile is written to the verbose stream if report is set.
+        */
+        void setup(bool report, bool track);
+
+        bool enabled() const { return m_enabled; }
+
+        void init_search() { m_watch.stop(); m_watch.reset(); m_watch.start(); }
+
+        /**
+           \brief return the length of the longest chain of instances of q that produced the bindings.
+        */
+        unsigned loop_depth(quantifier * q, unsigned num_bindings, enode * const * bindings) const;
+
+        /**
+           \brief record an instance of q and the edges from the producers of its bindings.
+        */
+        void add_instance(quantifier * q, unsigned generation, unsigned loop_depth, unsigned num_bindings, enode * const * bindings);
+
+        /**
+           \brief record the terms created by an instance of q.
+        */
+        void add_terms(quantifier * q, unsigned loop_depth, unsigned num_terms, enode * const * terms);
+
+        void add_throttled(quantifier * q);
+
+        void push_scope();
+        void pop_scope(unsigned num_scopes);
+        void reset();
+
+        /**
+           \brief write the profiles that changed since the last call to the verbose stream.
+        */
+        void flush();
+
+        void display(std::ostream & out) const;
+        void collect_statistics(::statistics & st) const;
+    };
+};
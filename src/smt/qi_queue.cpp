@@ -38,12 +38,14 @@ namespace smt {
         m_parser(m),
         m_evaluator(m),
         m_subst(m),
-        m_instances(m) {
+        m_instances(m),
+        m_profiler(m) {
         init_parser_vars();
         m_vals.resize(15, 0.0f);
     }
 
     qi_queue::~qi_queue() {
+        m_profiler.flush();
     }
 
     void qi_queue::setup() {
@@ -63,7 +65,11 @@ namespace smt {
             warning_msg("invalid new_gen function '%s', switching to default one", m_params.m_qi_new_gen.c_str());
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
+        // fall back to the interpreter if the functions use operators the compiler does not handle.
+        m_cost_program.compile(m, m_cost_function);
+        m_new_gen_program.compile(m, m_new_gen_function);
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
+        m_profiler.setup(m_params.m_qi_profile, m_params.m_qi_loop_limit > 0);
     }
 
     void qi_queue::init_parser_vars() {
@@ -122,7 +128,7 @@ namespace smt {
 
     float qi_queue::get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
         q::quantifier_stat * stat = set_values(q, pat, generation, min_top_generation, max_top_generation, 0);
-        float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
+        float r = m_cost_program.empty() ? m_evaluator(m_cost_function, m_vals.size(), m_vals.data()) : m_cost_program(m_vals.size(), m_vals.data());
         stat->update_max_cost(r);
         return r;
     }
@@ -130,7 +136,7 @@ namespace smt {
     unsigned qi_queue::get_new_gen(quantifier * q, unsigned generation, float cost) {
         // max_top_generation and min_top_generation are not available for computing inc_gen
         set_values(q, nullptr, generation, 0, 0, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        float r = m_new_gen_program.empty() ? m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data()) : m_new_gen_program(m_vals.size(), m_vals.data());
         if (q->get_weight() > 0 || r > 0)
             return static_cast<unsigned>(r);
         return std::max(generation + 1, static_cast<unsigned>(r));
@@ -159,7 +165,16 @@ namespace smt {
             fingerprint * f    = curr.m_qb;
             quantifier * qa    = static_cast<quantifier*>(f->get_data());
 
-            if (curr.m_cost <= m_eager_cost_threshold) {
+            if (is_throttled(curr)) {
+                TRACE("qi_queue", tout << "throttling matching loop of " << qa->get_qid() << "\n";);
+                m_profiler.add_throttled(qa);
+                // throttled instances are postponed to the final check,
+                // unless they are too expensive to be instantiated lazily.
+                if (curr.m_cost <= m_params.m_qi_lazy_threshold)
+                    m_pending.push_back(m_delayed_entries.size());
+                m_delayed_entries.push_back(curr);
+            }
+            else if (curr.m_cost <= m_eager_cost_threshold) {
                 instantiate(curr);
             }
             else if (m_params.m_qi_promote_unsat && m_checker.is_unsat(qa->get_expr(), f->get_num_args(), f->get_args())) {
@@ -169,6 +184,8 @@ namespace smt {
             }
             else {
                 TRACE("qi_queue", tout << "delaying quantifier instantiation... " << f << "\n" << mk_pp(qa, m) << "\ncost: " << curr.m_cost << "\n";);
+                if (curr.m_cost <= m_params.m_qi_lazy_threshold)
+                    m_pending.push_back(m_delayed_entries.size());
                 m_delayed_entries.push_back(curr);
             }
 
@@ -184,6 +201,18 @@ namespace smt {
         TRACE("new_entries_bug", tout << "[qi:instantiate]\n";);
     }
 
+    /**
+       \brief an entry is throttled if its instance belongs to a chain of instances of the
+       same quantifier that is longer than qi.loop_limit.
+    */
+    bool qi_queue::is_throttled(entry const & ent) {
+        if (m_params.m_qi_loop_limit == 0)
+            return false;
+        fingerprint * f = ent.m_qb;
+        quantifier * q  = static_cast<quantifier*>(f->get_data());
+        return m_profiler.loop_depth(q, f->get_num_args(), f->get_args()) > m_params.m_qi_loop_limit;
+    }
+
     void qi_queue::display_instance_profile(fingerprint * f, quantifier * q, unsigned num_bindings, enode * const * bindings, unsigned proof_id, unsigned generation) {
         if (m.has_trace_stream()) {
             m.trace_stream() << "[instance] ";
@@ -324,7 +353,12 @@ namespace smt {
         m_stats.m_num_instances++;
         unsigned gen = get_new_gen(q, generation, ent.m_cost);
         display_instance_profile(f, q, num_bindings, bindings, proof_id, gen);
+        unsigned num_enodes = m_context.enodes().size();
+        unsigned loop_depth = m_profiler.loop_depth(q, num_bindings, bindings);
+        m_profiler.add_instance(q, gen, loop_depth, num_bindings, bindings);
         m_context.internalize_instance(lemma, pr1, gen);
+        if (m_profiler.enabled() && m_context.enodes().size() > num_enodes)
+            m_profiler.add_terms(q, loop_depth, m_context.enodes().size() - num_enodes, m_context.enodes().data() + num_enodes);
         if (f->get_def()) {
             m_context.internalize(f->get_def(), true);
         }
@@ -366,6 +400,7 @@ namespace smt {
         s.m_delayed_entries_lim    = m_delayed_entries.size();
         s.m_instances_lim          = m_instances.size();
         s.m_instantiated_trail_lim = m_instantiated_trail.size();
+        m_profiler.push_scope();
     }
 
     void qi_queue::pop_scope(unsigned num_scopes) {
@@ -373,24 +408,40 @@ namespace smt {
         scope & s           = m_scopes[new_lvl];
         unsigned old_sz     = s.m_instantiated_trail_lim;
         unsigned sz         = m_instantiated_trail.size();
-        for (unsigned i = old_sz; i < sz; i++)
-            m_delayed_entries[m_instantiated_trail[i]].m_instantiated = false;
+        unsigned lim        = s.m_delayed_entries_lim;
+        unsigned j = 0;
+        for (unsigned idx : m_pending)
+            if (idx < lim)
+                m_pending[j++] = idx;
+        m_pending.shrink(j);
+        for (unsigned i = old_sz; i < sz; i++) {
+            unsigned idx = m_instantiated_trail[i];
+            m_delayed_entries[idx].m_instantiated = false;
+            if (idx < lim)
+                m_pending.push_back(idx);
+        }
+        if (j < m_pending.size())
+            std::sort(m_pending.begin(), m_pending.end());
         m_instantiated_trail.shrink(old_sz);
-        m_delayed_entries.shrink(s.m_delayed_entries_lim);
+        m_delayed_entries.shrink(lim);
         m_instances.shrink(s.m_instances_lim);
         m_new_entries.reset();
         m_scopes.shrink(new_lvl);
+        m_profiler.pop_scope(num_scopes);
         TRACE("new_entries_bug", tout << "[qi:pop-scope]\n";);
     }
 
     void qi_queue::reset() {
         m_new_entries.reset();
         m_delayed_entries.reset();
+        m_pending.reset();
         m_instances.reset();
         m_scopes.reset();
+        m_profiler.reset();
     }
 
     void qi_queue::init_search_eh() {
+        m_profiler.init_search();
         m_subst.reset();
         m_new_entries.reset();
     }
@@ -398,52 +449,48 @@ namespace smt {
     bool qi_queue::final_check_eh() {
         TRACE("qi_queue", display_delayed_instances_stats(tout); tout << "lazy threshold: " << m_params.m_qi_lazy_threshold
               << ", scope_level: " << m_context.get_scope_level() << "\n";);
+        m_profiler.flush();
 
+        // only entries in m_pending are candidates, so the check does not rescan
+        // the delayed entries that were already instantiated or are above the threshold.
+        bool result = m_pending.empty();
         if (m_params.m_qi_conservative_final_check) {
-            bool  init = false;
             float min_cost = 0.0;
-            unsigned sz = m_delayed_entries.size();
-            for (unsigned i = 0; i < sz; i++) {
-                entry & e       = m_delayed_entries[i];
+            for (unsigned i = 0; i < m_pending.size(); i++) {
+                entry & e       = m_delayed_entries[m_pending[i]];
                 TRACE("qi_queue", tout << e.m_qb << ", cost: " << e.m_cost << ", instantiated: " << e.m_instantiated << "\n";);
-                if (!e.m_instantiated && e.m_cost <= m_params.m_qi_lazy_threshold && (!init || e.m_cost < min_cost)) {
-                    init = true;
+                if (i == 0 || e.m_cost < min_cost)
                     min_cost = e.m_cost;
-                }
             }
             TRACE("qi_queue_min_cost", tout << "min_cost: " << min_cost << ", scope_level: " << m_context.get_scope_level() << "\n";);
-            bool result = true;
-            for (unsigned i = 0; i < sz; i++) {
-                entry & e       = m_delayed_entries[i];
-                TRACE("qi_queue", tout << e.m_qb << ", cost: " << e.m_cost << " min-cost: " << min_cost << ", instantiated: " << e.m_instantiated << "\n";);
-                if (!e.m_instantiated && e.m_cost <= min_cost) {
-                    TRACE("qi_queue",
-                          tout << "lazy quantifier instantiation...\n" << mk_pp(static_cast<quantifier*>(e.m_qb->get_data()), m) << "\ncost: " << e.m_cost << "\n";);
-                    result             = false;
-                    m_instantiated_trail.push_back(i);
-                    m_stats.m_num_lazy_instances++;
-                    instantiate(e);
-                }
+            unsigned j = 0;
+            for (unsigned i = 0; i < m_pending.size(); i++) {
+                unsigned idx    = m_pending[i];
+                if (m_delayed_entries[idx].m_cost <= min_cost)
+                    instantiate_pending(idx);
+                else
+                    m_pending[j++] = idx;
             }
+            m_pending.shrink(j);
             return result;
         }
 
-        bool result = true;
-        for (unsigned i = 0; i < m_delayed_entries.size(); i++) {
-            entry & e       = m_delayed_entries[i];
-            TRACE("qi_queue", tout << e.m_qb << ", cost: " << e.m_cost << ", instantiated: " << e.m_instantiated << "\n";);
-            if (!e.m_instantiated && e.m_cost <= m_params.m_qi_lazy_threshold)  {
-                TRACE("qi_queue",
-                      tout << "lazy quantifier instantiation...\n" << mk_pp(static_cast<quantifier*>(e.m_qb->get_data()), m) << "\ncost: " << e.m_cost << "\n";);
-                result             = false;
-                m_instantiated_trail.push_back(i);
-                m_stats.m_num_lazy_instances++;
-                instantiate(e);
-            }
-        }
+        for (unsigned i = 0; i < m_pending.size(); i++)
+            instantiate_pending(m_pending[i]);
+        m_pending.reset();
         return result;
     }
 
+    void qi_queue::instantiate_pending(unsigned i) {
+        entry & e = m_delayed_entries[i];
+        SASSERT(!e.m_instantiated && e.m_cost <= m_params.m_qi_lazy_threshold);
+        TRACE("qi_queue",
+              tout << "lazy quantifier instantiation...\n" << mk_pp(static_cast<quantifier*>(e.m_qb->get_data()), m) << "\ncost: " << e.m_cost << "\n";);
+        m_instantiated_trail.push_back(i);
+        m_stats.m_num_lazy_instances++;
+        instantiate(e);
+    }
+
     struct delayed_qa_info {
         unsigned m_num;
         float    m_min_cost;
@@ -507,6 +554,7 @@ namespace smt {
         get_min_max_costs(min, max);
         st.update("min missed qa cost", min);
         st.update("max missed qa cost", max);
+        m_profiler.collect_statistics(st);
 #if 0
         if (m_params.m_qi_profile) {
             out << "missed/delayed quantifier instances:\n";
@@ -25,6 +25,7 @@ Revision History:
 #include "smt/smt_checker.h"
 #include "smt/smt_quantifier.h"
 #include "smt/fingerprints.h"
+#include "smt/qi_profiler.h"
 #include "smt/params/qi_params.h"
 #include "ast/cost_evaluator.h"
 #include "util/statistics.h"
@@ -49,6 +50,8 @@ namespace smt {
         expr_ref                      m_new_gen_function;
         cost_parser                   m_parser;
         cost_evaluator                m_evaluator;
+        cost_program                  m_cost_program;
+        cost_program                  m_new_gen_program;
         cached_var_subst              m_subst;
         svector<float>                m_vals;
         double                        m_eager_cost_threshold;
@@ -63,18 +66,23 @@ namespace smt {
         svector<entry>                m_delayed_entries;
         expr_ref_vector               m_instances;
         unsigned_vector               m_instantiated_trail;
+        // indices of delayed entries below the lazy threshold that were not instantiated yet, in ascending order.
+        unsigned_vector               m_pending;
         struct scope {
             unsigned   m_delayed_entries_lim;
             unsigned   m_instances_lim;
             unsigned   m_instantiated_trail_lim;
         };
         svector<scope>                m_scopes;
+        qi_profiler                   m_profiler;
 
         void init_parser_vars();
         q::quantifier_stat * set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost);
         float get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
         unsigned get_new_gen(quantifier * q, unsigned generation, float cost);
         void instantiate(entry & ent);
+        void instantiate_pending(unsigned i);
+        bool is_throttled(entry const & ent);
         void get_min_max_costs(float & min, float & max) const;
         void display_instance_profile(fingerprint * f, quantifier * q, unsigned num_bindings, enode * const * bindings, unsigned proof_id, unsigned generation);
 
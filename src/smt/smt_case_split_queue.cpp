@@ -1243,6 +1243,237 @@ namespace {
 
         }
     };
+
+    /**
+       \brief Case split queue based on the learned branching heuristics CHB
+       (conflict history based branching) and LRB (learning rate based branching).
+
+       Both heuristics reward variables that participate in recent conflicts and
+       keep the rewards in an exponential moving average whose step decreases
+       from 0.4 to 0.06 during the search.
+       - CHB rewards the variables assigned since the last update with
+         multiplier / (conflicts since v participated in a conflict + 1), where
+         the multiplier is 1.0 if a conflict occurred since the last update and 0.9 otherwise.
+       - LRB rewards a variable when it is unassigned with the fraction of the
+         conflicts since its assignment in which it participated.
+
+       When case_split=9 the queue switches between the activity of the context
+       and LRB every branching.switch_interval conflicts if the conflict rate
+       (conflicts per decision) of the other heuristic was higher in its last window.
+
+       The rewards of theory atoms are scaled by branching.theory_weight.
+    */
+    class lrb_case_split_queue : public case_split_queue {
+        struct score_lt {
+            svector<double> const * const & m_scores;
+            score_lt(svector<double> const * const & s):m_scores(s) {}
+            bool operator()(bool_var v1, bool_var v2) const {
+                return (*m_scores)[v1] > (*m_scores)[v2];
+            }
+        };
+
+        context &               m_context;
+        smt_params &            m_params;
+        bool                    m_chb;
+        bool                    m_adaptive;
+        bool                    m_use_activity = false;
+        svector<double>         m_score;
+        svector<double> const * m_scores;        // m_score or the activity of the context
+        heap<score_lt>          m_queue;
+        unsigned_vector         m_last_conflict;  // CHB: last conflict in which the variable participated
+        bool_var_vector         m_assigned;       // CHB: variables assigned since the last update
+        unsigned_vector         m_assigned_at;    // LRB: number of conflicts when the variable was assigned, UINT_MAX if it is not assigned
+        unsigned_vector         m_participated;   // LRB: number of conflicts since then in which the variable participated
+        double                  m_step = 0.4;
+        unsigned                m_num_conflicts = 0;
+        unsigned                m_ctx_conflicts = 0; // value of context::get_num_conflicts() at the last conflict
+        unsigned                m_updated_at = 0;    // CHB: value of m_num_conflicts at the last update
+        unsigned                m_window_conflicts = 0;
+        unsigned                m_window_decisions = 0;
+        double                  m_rate[2] = { -1.0, -1.0 }; // conflict rate of LRB and activity in their last window
+
+        void new_conflict_eh() {
+            unsigned c = m_context.get_num_conflicts();
+            if (c == m_ctx_conflicts)
+                return;
+            m_ctx_conflicts = c;
+            m_num_conflicts++;
+            m_window_conflicts++;
+            m_step = std::max(0.06, m_step - 1e-6);
+        }
+
+        double weight(bool_var v) const {
+            return m_context.get_bdata(v).is_theory_atom() ? m_params.m_branching_theory_weight : 1.0;
+        }
+
+        void update_score(bool_var v, double reward) {
+            double old_score = m_score[v];
+            m_score[v] = (1.0 - m_step) * old_score + m_step * reward * weight(v);
+            if (m_use_activity || !m_queue.contains(v))
+                return;
+            if (m_score[v] > old_score)
+                m_queue.decreased(v);
+            else
+                m_queue.increased(v);
+        }
+
+        void update_chb() {
+            if (m_assigned.empty())
+                return;
+            double multiplier = m_updated_at != m_num_conflicts ? 1.0 : 0.9;
+            for (bool_var v : m_assigned)
+                update_score(v, multiplier / (m_num_conflicts - m_last_conflict[v] + 1));
+            m_assigned.reset();
+            m_updated_at = m_num_conflicts;
+        }
+
+        void use_activity(bool f) {
+            m_use_activity = f;
+            m_scores = f ? &m_context.get_activity_vector() : &m_score;
+            m_queue.reset();
+            unsigned num_vars = m_context.get_num_bool_vars();
+            m_queue.reserve(num_vars);
+            for (bool_var v = 0; v < num_vars; ++v)
+                if (m_context.get_assignment(v) == l_undef)
+                    m_queue.insert(v);
+        }
+
+        void update_mode() {
+            if (m_window_conflicts < m_params.m_branching_switch_interval)
+                return;
+            double rate = static_cast<double>(m_window_conflicts) / std::max(1u, m_window_decisions);
+            m_rate[m_use_activity] = rate;
+            m_window_conflicts = 0;
+            m_window_decisions = 0;
+            double other = m_rate[!m_use_activity];
+            if (other < 0 || other > rate) {
+                IF_VERBOSE(2, verbose_stream() << "(smt.case-split :switch-to " << (m_use_activity ? "lrb" : "activity") << " :conflict-rate " << rate << ")\n";);
+                use_activity(!m_use_activity);
+            }
+        }
+
+    public:
+        lrb_case_split_queue(context & ctx, smt_params & p):
+            m_context(ctx),
+            m_params(p),
+            m_chb(p.m_case_split_strategy == CS_CHB),
+            m_adaptive(p.m_case_split_strategy == CS_ACTIVITY_LRB),
+            m_scores(&m_score),
+            m_queue(1024, score_lt(m_scores)) {
+        }
+
+        void activity_increased_eh(bool_var v) override {
+            new_conflict_eh();
+            if (m_chb)
+                m_last_conflict[v] = m_num_conflicts;
+            else
+                m_participated[v]++;
+            if (m_use_activity && m_queue.contains(v))
+                m_queue.decreased(v);
+        }
+
+        void activity_decreased_eh(bool_var v) override {
+            if (m_use_activity && m_queue.contains(v))
+                m_queue.increased(v);
+        }
+
+        void mk_var_eh(bool_var v) override {
+            m_score.reserve(v + 1, 0.0);
+            m_last_conflict.reserve(v + 1, 0);
+            m_assigned_at.reserve(v + 1, UINT_MAX);
+            m_participated.reserve(v + 1, 0);
+            m_score[v] = 0.0;
+            m_last_conflict[v] = 0;
+            m_assigned_at[v] = UINT_MAX;
+            m_queue.reserve(v + 1);
+            SASSERT(!m_queue.contains(v));
+            m_queue.insert(v);
+        }
+
+        void del_var_eh(bool_var v) override {
+            if (m_queue.contains(v))
+                m_queue.erase(v);
+        }
+
+        void assign_lit_eh(literal l) override {
+            bool_var v = l.var();
+            if (m_chb) {
+                m_assigned.push_back(v);
+            }
+            else {
+                m_assigned_at[v] = m_num_conflicts;
+                m_participated[v] = 0;
+            }
+        }
+
+        void unassign_var_eh(bool_var v) override {
+            if (m_chb) {
+                update_chb();
+            }
+            else if (m_assigned_at[v] != UINT_MAX) {
+                unsigned interval = m_num_conflicts - m_assigned_at[v];
+                if (interval > 0)
+                    update_score(v, static_cast<double>(m_participated[v]) / interval);
+                m_assigned_at[v] = UINT_MAX;
+            }
+            if (!m_queue.contains(v))
+                m_queue.insert(v);
+        }
+
+        void relevant_eh(expr * n) override {}
+
+        void init_search_eh() override {}
+
+        void end_search_eh() override {}
+
+        void reset() override {
+            m_queue.reset();
+            m_assigned.reset();
+        }
+
+        void push_scope() override {}
+
+        void pop_scope(unsigned num_scopes) override {}
+
+        void next_case_split(bool_var & next, lbool & phase) override {
+            phase = l_undef;
+            if (m_chb)
+                update_chb();
+            if (m_adaptive)
+                update_mode();
+            m_window_decisions++;
+
+            if (m_context.get_random_value() < static_cast<int>(m_params.m_random_var_freq * random_gen::max_value())) {
+                next = m_context.get_random_value() % m_context.get_num_b_internalized();
+                TRACE("random_split", tout << "next: " << next << " get_assignment(next): " << m_context.get_assignment(next) << "\n";);
+                if (m_context.get_assignment(next) == l_undef)
+                    return;
+            }
+
+            while (!m_queue.empty()) {
+                next = m_queue.erase_min();
+                if (m_context.get_assignment(next) == l_undef)
+                    return;
+            }
+
+            next = null_bool_var;
+        }
+
+        void display(std::ostream & out) override {
+            bool first = true;
+            for (unsigned v : m_queue) {
+                if (m_context.get_assignment(v) == l_undef) {
+                    if (first) {
+                        out << "remaining case-splits:\n";
+                        first = false;
+                    }
+                    out << "#" << m_context.bool_var2expr(v)->get_id() << " ";
+                }
+            }
+            if (!first)
+                out << "\n";
+        }
+    };
 }
 
 namespace smt {
@@ -1270,6 +1501,10 @@ namespace smt {
             return alloc(rel_goal_case_split_queue, ctx, p);
         case CS_ACTIVITY_THEORY_AWARE_BRANCHING:
             return alloc(theory_aware_branching_queue, ctx, p);
+        case CS_CHB:
+        case CS_LRB:
+        case CS_ACTIVITY_LRB:
+            return alloc(lrb_case_split_queue, ctx, p);
         default:
             return alloc(act_case_split_queue, ctx, p);
         }
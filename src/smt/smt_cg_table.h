@@ -20,7 +20,7 @@ Revision History:
 
 #include "smt/smt_enode.h"
 #include "util/hashtable.h"
-#include "util/chashtable.h"
+#include "util/oa_hashtable.h"
 
 namespace smt {
 
@@ -48,7 +48,7 @@ namespace smt {
             }
         };
 
-        typedef chashtable<enode *, cg_unary_hash, cg_unary_eq> unary_table;
+        typedef oa_hashtable<enode *, cg_unary_hash, cg_unary_eq> unary_table;
         
         struct cg_binary_hash {
             unsigned operator()(enode * n) const {
@@ -68,7 +68,7 @@ namespace smt {
             }
         };
 
-        typedef chashtable<enode*, cg_binary_hash, cg_binary_eq> binary_table;
+        typedef oa_hashtable<enode*, cg_binary_hash, cg_binary_eq> binary_table;
         
         struct cg_comm_hash {
             unsigned operator()(enode * n) const {
@@ -103,7 +103,7 @@ namespace smt {
             }
         };
 
-        typedef chashtable<enode*, cg_comm_hash, cg_comm_eq> comm_table;
+        typedef oa_hashtable<enode*, cg_comm_hash, cg_comm_eq> comm_table;
 
         struct cg_hash {
             unsigned operator()(enode * n) const;
@@ -113,7 +113,7 @@ namespace smt {
             bool operator()(enode * n1, enode * n2) const;
         };
 
-        typedef chashtable<enode*, cg_hash, cg_eq> table;
+        typedef oa_hashtable<enode*, cg_hash, cg_eq> table;
 
         ast_manager &                 m_manager;
         bool                          m_commutativity; //!< true if the last found congruence used commutativity
@@ -183,6 +183,32 @@ namespace smt {
             }
         }
 
+        /**
+           \brief Similar to find, but neither the table nor n are updated,
+           so lookups can run concurrently. The result is nullptr if there is no
+           table for the declaration of n.
+        */
+        enode * lookup(enode * n) const {
+            SASSERT(n->get_num_args() > 0);
+            unsigned tid;
+            if (!m_func_decl2id.find(n->get_decl(), tid))
+                return nullptr;
+            enode * r = nullptr;
+            void * t = m_tables[tid];
+            switch (static_cast<table_kind>(GET_TAG(t))) {
+            case UNARY:
+                return UNTAG(unary_table*, t)->find(n, r) ? r : nullptr;
+            case BINARY:
+                return UNTAG(binary_table*, t)->find(n, r) ? r : nullptr;
+            case BINARY_COMM: {
+                bool commutativity = false;
+                return UNTAG(comm_table*, t)->find(n, r, cg_comm_eq(commutativity)) ? r : nullptr;
+            }
+            default:
+                return UNTAG(table*, t)->find(n, r) ? r : nullptr;
+            }
+        }
+
         bool contains_ptr(enode * n) const {
             enode * r;
             SASSERT(n->get_num_args() > 0);
@@ -644,7 +644,7 @@ namespace smt {
         bool_var var = antecedent.var();
         unsigned lvl = m_ctx.get_assign_level(var);
         if (!m_ctx.is_marked(var) && lvl > m_ctx.get_base_level()) {
-            if (m_lvl_set.may_contain(lvl)) {
+            if (m_lvl_set.may_contain(lvl) && !m_min_failed.contains(var)) {
                 m_ctx.set_mark(var);
                 m_unmark.push_back(var);
                 m_lemma_min_stack.push_back(var);
@@ -657,15 +657,21 @@ namespace smt {
     }
 
     bool conflict_resolution::process_justification_for_minimization(justification * js) {
+        if (m_min_failed_js.contains(js))
+            return false;
         literal_vector & antecedents = m_tmp_literal_vector;
         antecedents.reset();
         // Invoking justification2literals_core will not reset the caches for visited justifications and eqs.
         // The method unmark_justifications must be invoked to reset these caches.
         // Remark: The method reset_unmark_and_justifications invokes unmark_justifications.
         justification2literals_core(js, antecedents);
-        for (literal l : antecedents) 
-            if (!process_antecedent_for_minimization(l))
+        for (literal l : antecedents) {
+            if (!process_antecedent_for_minimization(l)) {
+                // theory explanations are expensive, do not expand js again in this minimization.
+                m_min_failed_js.insert(js);
                 return false;
+            }
+        }
         return true;
     }
 
@@ -675,6 +681,8 @@ namespace smt {
        The set lvl_set is used as an optimization.
        The idea is to stop the recursive search with a failure
        as soon as we find a literal assigned in a level that is not in lvl_set.
+       The variable whose justification caused the failure is recorded in m_min_failed,
+       so that searches for the remaining literals of the lemma fail on it immediately.
     */
     bool conflict_resolution::implied_by_marked(literal lit) {
         m_lemma_min_stack.reset();  // avoid recursive function
@@ -697,6 +705,7 @@ namespace smt {
                         literal l = (*cls)[i];
                         SASSERT(l.var() != var);
                         if (!process_antecedent_for_minimization(~l)) {
+                            m_min_failed.insert(var);
                             reset_unmark_and_justifications(old_size, old_js_qhead);
                             return false;
                         }
@@ -704,6 +713,7 @@ namespace smt {
                 }
                 justification * js = cls->get_justification();
                 if (js && !process_justification_for_minimization(js)) {
+                    m_min_failed.insert(var);
                     reset_unmark_and_justifications(old_size, old_js_qhead);
                     return false;
                 }
@@ -711,6 +721,7 @@ namespace smt {
             }
             case b_justification::BIN_CLAUSE:
                 if (!process_antecedent_for_minimization(js.get_literal())) {
+                    m_min_failed.insert(var);
                     reset_unmark_and_justifications(old_size, old_js_qhead);
                     return false;
                 }
@@ -718,12 +729,14 @@ namespace smt {
             case b_justification::AXIOM:
                 // it is a decision variable from a previous scope level or an assumption
                 if (m_ctx.get_assign_level(var) > m_ctx.get_base_level()) {
+                    m_min_failed.insert(var);
                     reset_unmark_and_justifications(old_size, old_js_qhead);
                     return false;
                 }
                 break;
             case b_justification::JUSTIFICATION:
                 if (m_ctx.is_assumption(var) || !process_justification_for_minimization(js.get_justification())) {
+                    m_min_failed.insert(var);
                     reset_unmark_and_justifications(old_size, old_js_qhead);
                     return false;
                 }
@@ -740,6 +753,8 @@ namespace smt {
     */
     void conflict_resolution::minimize_lemma() {
         m_unmark.reset();
+        m_min_failed.reset();
+        m_min_failed_js.reset();
 
         m_lvl_set   = get_lemma_approx_level_set();
 
@@ -765,6 +780,42 @@ namespace smt {
         m_lemma_atoms.shrink(j);
         m_ctx.m_stats.m_num_minimized_lits += sz - j;
         TRACE("conflict", tout << "lemma: " << m_lemma << "\n";);
+
+        minimize_lemma_binres();
+    }
+
+    /**
+       \brief Remove the literals l of the lemma such that (m_lemma[0] or ~l) is a
+       binary clause, that is, ~m_lemma[0] implies ~l in the binary implication graph.
+       Resolving the lemma with the binary clause yields the lemma without l.
+
+       Binary clauses are stored in the watch lists only when binary_clause_opt_enabled().
+
+       \warning This method assumes the literals in m_lemma[1] ... m_lemma[m_lemma.size() - 1] are marked.
+    */
+    void conflict_resolution::minimize_lemma_binres() {
+        if (!m_ctx.binary_clause_opt_enabled() || m_lemma.size() <= 1)
+            return;
+        // the binary clause (m_lemma[0] or ~l) is in the watch list of ~m_lemma[0] as ~l,
+        // and ~l is true because l is false.
+        for (literal l : watch_list::literal_iterator(m_watches[(~m_lemma[0]).index()]))
+            if (m_ctx.is_marked(l.var()) && m_ctx.get_assignment(l) == l_true)
+                m_ctx.unset_mark(l.var());
+        unsigned sz = m_lemma.size();
+        unsigned j  = 1;
+        for (unsigned i = 1; i < sz; i++) {
+            literal l = m_lemma[i];
+            if (l.var() != null_bool_var && !m_ctx.is_marked(l.var()))
+                continue;
+            if (j != i) {
+                m_lemma[j] = l;
+                m_lemma_atoms.set(j, m_lemma_atoms.get(i));
+            }
+            j++;
+        }
+        m_lemma      .shrink(j);
+        m_lemma_atoms.shrink(j);
+        m_ctx.m_stats.m_num_minimized_lits += sz - j;
     }
 
     /**
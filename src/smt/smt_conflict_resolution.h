@@ -29,6 +29,7 @@ Revision History:
 #include "util/map.h"
 #include "smt/watch_list.h"
 #include "util/obj_pair_set.h"
+#include "util/uint_set.h"
 
 typedef approx_set_tpl<unsigned, u2u, unsigned> level_approx_set;
 
@@ -182,6 +183,10 @@ namespace smt {
         bool_var_vector m_unmark;
         bool_var_vector m_lemma_min_stack;
         level_approx_set m_lvl_set;
+        // variables and theory justifications that are known not to be implied
+        // by the lemma during the current call to minimize_lemma.
+        tracked_uint_set                  m_min_failed;
+        ptr_addr_hashtable<justification> m_min_failed_js;
         level_approx_set get_lemma_approx_level_set();
         void reset_unmark(unsigned old_size);
         void reset_unmark_and_justifications(unsigned old_size, unsigned old_js_qhead);
@@ -189,6 +194,7 @@ namespace smt {
         bool process_justification_for_minimization(justification * js);
         bool implied_by_marked(literal lit);
         void minimize_lemma();
+        void minimize_lemma_binres();
 
         void structural_minimization();
 
@@ -182,6 +182,8 @@ namespace smt {
     }
 
     context::~context() {
+        dealloc(m_par);
+        m_par = nullptr;
         flush();
         m_asserted_formulas.finalize();
     }
@@ -1293,6 +1295,10 @@ namespace smt {
         return r;
     }
 
+    enode * context::find_enode_eq_to(tmp_enode & tmp, func_decl * f, unsigned num_args, enode * const * args) const {
+        return m_cg_table.lookup(tmp.set(f, num_args, args));
+    }
+
     /**
        \brief Process the equality propagation queue.
 
@@ -2418,6 +2424,7 @@ namespace smt {
             TRACE("context", tout << "backtracking new_lvl: " << new_lvl << "\n";);
 
             units_to_reassert_lim = s.m_units_to_reassert_lim;
+            dyn_ack_manager::scoped_backtrack _backtrack(m_dyn_ack_manager);
 
             if (new_lvl < m_base_lvl) {
                 base_scope & bs = m_base_scopes[new_lvl];
@@ -2983,6 +2990,8 @@ namespace smt {
         m_base_lvl++;
         m_search_lvl++; // Not really necessary. But, it is useful to enforce the invariant m_search_lvl >= m_base_lvl
         SASSERT(m_base_lvl <= m_scope_lvl);
+        if (m_par)
+            m_par->push();
     }
 
     void context::pop(unsigned num_scopes) {
@@ -2990,6 +2999,8 @@ namespace smt {
         if (num_scopes > m_scope_lvl) return;
         pop_to_base_lvl();
         pop_scope(num_scopes);
+        if (m_par)
+            m_par->pop(num_scopes);
     }
 
     /**
@@ -3554,9 +3565,10 @@ namespace smt {
         setup_context(m_fparams.m_auto_config);
 
         if (m_fparams.m_threads > 1 && !m.has_trace_stream()) {
-            parallel p(*this);
+            if (!m_par)
+                m_par = alloc(parallel, *this);
             expr_ref_vector asms(m);
-            return p(asms);
+            return (*m_par)(asms);
         }
 
         try {
@@ -3620,8 +3632,9 @@ namespace smt {
         setup_context(false);
         if (m_fparams.m_threads > 1 && !m.has_trace_stream()) {            
             expr_ref_vector asms(m, num_assumptions, assumptions);
-            parallel p(*this);
-            return p(asms);
+            if (!m_par)
+                m_par = alloc(parallel, *this);
+            return (*m_par)(asms);
         }
         lbool r = l_undef;
         do {
@@ -1152,6 +1152,12 @@ namespace smt {
 
         enode * get_enode_eq_to(func_decl * f, unsigned num_args, enode * const * args);
 
+        /**
+           \brief Similar to get_enode_eq_to, but the lookup uses the temporary enode tmp
+           and does not update the context. It is used by matching threads.
+        */
+        enode * find_enode_eq_to(tmp_enode & tmp, func_decl * f, unsigned num_args, enode * const * args) const;
+
         bool guess(bool_var var, lbool phase);
 
     protected:
@@ -24,6 +24,121 @@ Author:
 #include "smt/smt_parallel.h"
 #include "smt/smt_lookahead.h"
 
+namespace smt {
+
+    void parallel::init_workers(unsigned num_threads) {
+        ast_manager& m = ctx.m;
+        for (unsigned i = 0; i < num_threads; ++i) 
+            m_params.push_back(alloc(smt_params, ctx.get_fparams()));
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager* new_m = alloc(ast_manager, m, true);
+            m_pms.push_back(new_m);
+            m_pctxs.push_back(alloc(context, *new_m, *m_params[i], ctx.get_params())); 
+            context& new_ctx = *m_pctxs.back();
+            context::copy(ctx, new_ctx, true);
+            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
+        }
+        m_num_formulas = ctx.m_asserted_formulas.get_num_formulas();
+        m_num_formulas_lim.reset();
+        m_num_macros = ctx.m_asserted_formulas.get_macro_manager().get_num_macros();
+        m_num_macros_lim.reset();
+        m_unit_qhead.fill(num_threads, 0);
+        m_assigned_qhead.fill(num_threads, 0);
+        m_lemma_qhead.fill(num_threads, 0);
+    }
+
+    /**
+       \brief assert formulas that were added to ctx since the workers were last synchronized.
+    */
+    void parallel::sync_workers() {
+        asserted_formulas& af = ctx.m_asserted_formulas;
+        unsigned sz = af.get_num_formulas();
+        // macros are removed from the formulas, so workers are recreated to pick them up.
+        if (sz < m_num_formulas || af.get_macro_manager().get_num_macros() != m_num_macros) {
+            reset_workers();
+            return;
+        }
+        for (context* pctx : m_pctxs) {
+            ast_translation tr(ctx.m, pctx->m);
+            for (unsigned i = m_num_formulas; i < sz; ++i) {
+                expr* fml = af.get_formula(i);
+                if (ctx.m.is_true(fml))
+                    continue;
+                proof* pr = af.get_formula_proof(i);
+                pctx->assert_expr(tr(fml), pr ? tr(pr) : nullptr);
+            }
+        }
+        m_num_formulas = sz;
+    }
+
+    void parallel::reset_workers() {
+        m_pctxs.reset();
+        m_pms.reset();
+        m_params.reset();
+        m_num_formulas = 0;
+        m_num_formulas_lim.reset();
+        m_num_macros = 0;
+        m_num_macros_lim.reset();
+        m_unit_set.reset();
+        m_unit_trail.reset();
+        m_unit_trail_lim.reset();
+        m_unit_qhead.reset();
+        m_assigned_qhead.reset();
+        m_clause_set.reset();
+        m_clause_trail.reset();
+        m_clause_trail_lim.reset();
+        m_clause_owner.reset();
+        m_clause_qhead = 0;
+        m_lemma_qhead.reset();
+    }
+
+    void parallel::push() {
+        if (m_pctxs.empty())
+            return;
+        m_num_formulas_lim.push_back(m_num_formulas);
+        m_num_macros_lim.push_back(m_num_macros);
+        m_unit_trail_lim.push_back(m_unit_trail.size());
+        m_clause_trail_lim.push_back(m_clause_trail.size());
+        for (context* pctx : m_pctxs)
+            pctx->push();
+    }
+
+    void parallel::pop(unsigned num_scopes) {
+        if (m_pctxs.empty())
+            return;
+        // the workers were created inside a scope that is now popped.
+        if (num_scopes > m_num_formulas_lim.size()) {
+            reset_workers();
+            return;
+        }
+        unsigned new_lvl = m_num_formulas_lim.size() - num_scopes;
+        m_num_formulas = m_num_formulas_lim[new_lvl];
+        m_num_formulas_lim.shrink(new_lvl);
+        m_num_macros = m_num_macros_lim[new_lvl];
+        m_num_macros_lim.shrink(new_lvl);
+        // units and clauses shared inside the popped scopes may depend on its assertions.
+        unsigned units_lim = m_unit_trail_lim[new_lvl];
+        for (unsigned i = units_lim; i < m_unit_trail.size(); ++i)
+            m_unit_set.remove(m_unit_trail.get(i));
+        m_unit_trail.shrink(units_lim);
+        m_unit_trail_lim.shrink(new_lvl);
+        unsigned clauses_lim = m_clause_trail_lim[new_lvl];
+        for (unsigned i = clauses_lim; i < m_clause_trail.size(); ++i)
+            m_clause_set.remove(m_clause_trail.get(i));
+        m_clause_trail.shrink(clauses_lim);
+        m_clause_owner.shrink(clauses_lim);
+        m_clause_trail_lim.shrink(new_lvl);
+        m_clause_qhead = std::min(m_clause_qhead, clauses_lim);
+        for (unsigned i = 0; i < m_pctxs.size(); ++i) {
+            context& pctx = *m_pctxs[i];
+            pctx.pop(num_scopes);
+            m_unit_qhead[i] = std::min(m_unit_qhead[i], units_lim);
+            m_assigned_qhead[i] = std::min(m_assigned_qhead[i], pctx.assigned_literals().size());
+            m_lemma_qhead[i] = std::min(m_lemma_qhead[i], pctx.get_lemmas().size());
+        }
+    }
+}
+
 #ifdef SINGLE_THREAD
 
 namespace smt {
@@ -36,6 +151,7 @@ namespace smt {
 #else
 
 #include <thread>
+#include <condition_variable>
 
 namespace smt {
     
@@ -46,6 +162,7 @@ namespace smt {
         flet<unsigned> _nt(ctx.m_fparams.m_threads, 1);
         unsigned thread_max_conflicts = ctx.get_fparams().m_threads_max_conflicts;
         unsigned max_conflicts = ctx.get_fparams().m_max_conflicts;
+        unsigned const user_max_conflicts = max_conflicts;
 
         // try first sequential with a low conflict budget to make super easy problems cheap
         unsigned max_c = std::min(thread_max_conflicts, 40u);
@@ -60,9 +177,6 @@ namespace smt {
             ERROR_EX
         };
 
-        vector<smt_params> smt_params;
-        scoped_ptr_vector<ast_manager> pms;
-        scoped_ptr_vector<context> pctxs;
         vector<expr_ref_vector> pasms;
 
         ast_manager& m = ctx.m;
@@ -76,20 +190,17 @@ namespace smt {
         if (m.has_trace_stream())
             throw default_exception("trace streams have to be off in parallel mode");
 
-        
-        for (unsigned i = 0; i < num_threads; ++i) {
-            smt_params.push_back(ctx.get_fparams());
+
+        if (m_pctxs.size() == num_threads) 
+            sync_workers();
+        if (m_pctxs.size() != num_threads) {
+            reset_workers();
+            init_workers(num_threads);
         }
         for (unsigned i = 0; i < num_threads; ++i) {
-            ast_manager* new_m = alloc(ast_manager, m, true);
-            pms.push_back(new_m);
-            pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
-            context& new_ctx = *pctxs.back();
-            context::copy(ctx, new_ctx, true);
-            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
+            ast_translation tr(m, *m_pms[i]);
             pasms.push_back(tr(asms));
-            sl.push_child(&(new_m->limit()));
+            sl.push_child(&(m_pms[i]->limit()));
         }
 
         auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
@@ -102,49 +213,87 @@ namespace smt {
             }
         };
 
-        obj_hashtable<expr> unit_set;
-        expr_ref_vector unit_trail(ctx.m);
-        unsigned_vector unit_lim;
-        for (unsigned i = 0; i < num_threads; ++i) unit_lim.push_back(0);
+        // learned clauses with at most share_size literals are shared with the other workers.
+        unsigned share_size = ctx.get_fparams().m_threads_share_size;
+
+        auto is_shareable = [&](context& pctx, clause const& cls) {
+            if (!cls.is_learned() || cls.get_num_literals() > share_size)
+                return false;
+            for (literal lit : cls) {
+                bool_var_data const& d = pctx.get_bdata(lit.var());
+                if (d.is_theory_atom() && !pctx.m_theories.get_plugin(d.get_theory())->is_safe_to_copy(lit.var()))
+                    return false;
+            }
+            return true;
+        };
 
         std::function<void(void)> collect_units = [&,this]() {
             for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
+                context& pctx = *m_pctxs[i];
                 pctx.pop_to_base_lvl();
                 ast_translation tr(pctx.m, ctx.m);
                 unsigned sz = pctx.assigned_literals().size();
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
+                for (unsigned j = m_assigned_qhead[i]; j < sz; ++j) {
                     literal lit = pctx.assigned_literals()[j];
                     expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
                     if (lit.sign()) e = pctx.m.mk_not(e);
                     expr_ref ce(tr(e.get()), ctx.m);
-                    if (!unit_set.contains(ce)) {
-                        unit_set.insert(ce);
-                        unit_trail.push_back(ce);
+                    if (!m_unit_set.contains(ce)) {
+                        m_unit_set.insert(ce);
+                        m_unit_trail.push_back(ce);
                     }
                 }
+                m_assigned_qhead[i] = sz;
+                clause_vector const& lemmas = pctx.get_lemmas();
+                expr_ref_vector lits(pctx.m);
+                for (unsigned j = std::min(m_lemma_qhead[i], lemmas.size()); j < lemmas.size(); ++j) {
+                    clause const& cls = *lemmas[j];
+                    if (!is_shareable(pctx, cls))
+                        continue;
+                    lits.reset();
+                    for (literal lit : cls) {
+                        expr_ref e(pctx.m);
+                        pctx.literal2expr(lit, e);
+                        lits.push_back(e);
+                    }
+                    expr_ref ce(tr(mk_or(lits).get()), ctx.m);
+                    if (!m_clause_set.contains(ce)) {
+                        m_clause_set.insert(ce);
+                        m_clause_trail.push_back(ce);
+                        m_clause_owner.push_back(i);
+                    }
+                }
+                m_lemma_qhead[i] = lemmas.size();
             }
 
-            unsigned sz = unit_trail.size();
+            unsigned sz = m_unit_trail.size();
             for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
+                context& pctx = *m_pctxs[i];
                 ast_translation tr(ctx.m, pctx.m);
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    expr_ref src(ctx.m), dst(pctx.m);
-                    dst = tr(unit_trail.get(j));
-                    pctx.assert_expr(dst);
-                }
-                unit_lim[i] = sz;
+                for (unsigned j = m_unit_qhead[i]; j < sz; ++j) 
+                    pctx.assert_expr(tr(m_unit_trail.get(j)));
+                m_unit_qhead[i] = sz;
             }
-            IF_VERBOSE(1, verbose_stream() << "(smt.thread :units " << sz << ")\n");
+            IF_VERBOSE(1, verbose_stream() << "(smt.thread :units " << sz << " :clauses " << m_clause_trail.size() << ")\n");
+        };
+
+        std::function<void(void)> share_clauses = [&,this]() {
+            for (unsigned i = 0; i < num_threads; ++i) {
+                context& pctx = *m_pctxs[i];
+                ast_translation tr(ctx.m, pctx.m);
+                for (unsigned j = m_clause_qhead; j < m_clause_trail.size(); ++j) 
+                    if (m_clause_owner[j] != i)
+                        pctx.assert_expr(tr(m_clause_trail.get(j)));
+            }
+            m_clause_qhead = m_clause_trail.size();
         };
 
         std::mutex mux;
 
         auto worker_thread = [&](int i) {
             try {
-                context& pctx = *pctxs[i];
-                ast_manager& pm = *pms[i];
+                context& pctx = *m_pctxs[i];
+                ast_manager& pm = *m_pms[i];
                 expr_ref_vector lasms(pasms[i]);
                 expr_ref c(pm);
 
@@ -184,7 +333,7 @@ namespace smt {
                     else if (!first) return;
                 }
 
-                for (ast_manager* m : pms) {
+                for (ast_manager* m : m_pms) {
                     if (m != &pm) m->limit().cancel();
                 }
 
@@ -212,9 +361,250 @@ namespace smt {
             }
         };
 
+        // Cube and conquer.
+        // Cubes are stored over ctx.m, which is only accessed under mux while workers run.
+        // Each worker owns a work queue. It takes its most recent cube, or steals the oldest cube 
+        // of another worker. A cube that exceeds its conflict budget is split by lookahead
+        // in the worker that owns it. A refuted cube contributes its negated core as a lemma to 
+        // all workers, and queued cubes that contain the cube literals of the core are pruned.
+        std::condition_variable cv;
+        vector<expr_ref_vector> cubes;
+        unsigned_vector cube_budget;
+        vector<unsigned_vector> work(num_threads);
+        expr_ref_vector lemmas(m), asms_core(m);
+        unsigned_vector lemma_owner;
+        obj_hashtable<expr> asms_core_set;
+        unsigned num_busy = 0, num_cubes = 1, num_refuted = 0, num_pruned = 0;
+        uint64_t num_cube_conflicts = 0;
+        bool exhausted = false;
+        cubes.push_back(expr_ref_vector(m));
+        cube_budget.push_back(thread_max_conflicts);
+        work[0].push_back(0);
+
+        auto has_work = [&]() {
+            for (auto const& w : work)
+                if (!w.empty())
+                    return true;
+            return false;
+        };
+
+        auto next_cube = [&](unsigned i, unsigned& idx) {
+            if (!work[i].empty()) {
+                idx = work[i].back();
+                work[i].pop_back();
+                return true;
+            }
+            for (unsigned j = 1; j < num_threads; ++j) {
+                auto& w = work[(i + j) % num_threads];
+                if (!w.empty()) {
+                    idx = w[0];
+                    w.erase(w.begin());
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        auto prune = [&](expr_ref_vector const& core_cube) {
+            for (auto& w : work) {
+                unsigned j = 0;
+                for (unsigned idx : w) {
+                    bool subsumed = all_of(core_cube, [&](expr* e) { return cubes[idx].contains(e); });
+                    if (subsumed)
+                        ++num_pruned;
+                    else
+                        w[j++] = idx;
+                }
+                w.shrink(j);
+            }
+        };
+
+        auto finish = [&](unsigned i, lbool r) {
+            // assumes mux is held
+            if (done)
+                return;
+            done = true;
+            finished_id = i;
+            result = r;
+            for (ast_manager* pm : m_pms) 
+                if (pm != m_pms[i]) 
+                    pm->limit().cancel();
+            cv.notify_all();
+        };
+
+        auto cancel_others = [&](unsigned i) {
+            // assumes mux is held
+            done = true;
+            for (ast_manager* pm : m_pms) 
+                if (pm != m_pms[i]) 
+                    pm->limit().cancel();
+            cv.notify_all();
+        };
+
+        auto cube_worker = [&](unsigned i) {
+            try {
+                context& pctx = *m_pctxs[i];
+                ast_manager& pm = *m_pms[i];
+                expr_ref_vector cube(pm), lasms(pm), lemmas_in(pm);
+                unsigned lemma_lim = 0;
+                while (true) {
+                    unsigned idx = 0, budget = 0;
+                    {
+                        std::unique_lock<std::mutex> lock(mux);
+                        cv.wait(lock, [&] { return done || num_busy == 0 || has_work(); });
+                        if (done)
+                            return;
+                        if (!next_cube(i, idx)) {
+                            // all cubes are refuted
+                            exhausted = true;
+                            finish(i, l_false);
+                            return;
+                        }
+                        ast_translation tr(m, pm);
+                        cube.reset();
+                        for (expr* e : cubes[idx])
+                            cube.push_back(tr(e));
+                        budget = cube_budget[idx];
+                        lemmas_in.reset();
+                        for (; lemma_lim < lemmas.size(); ++lemma_lim)
+                            if (lemma_owner[lemma_lim] != i)
+                                lemmas_in.push_back(tr(lemmas.get(lemma_lim)));
+                        ++num_busy;
+                    }
+                    for (expr* e : lemmas_in)
+                        pctx.assert_expr(e);
+                    lasms.reset();
+                    lasms.append(pasms[i]);
+                    lasms.append(cube);
+                    pctx.get_fparams().m_max_conflicts = budget;
+                    IF_VERBOSE(2, verbose_stream() << "(smt.thread " << i << " :cube " << cube.size() << " :budget " << budget << ")\n");
+                    lbool r = pctx.check(lasms.size(), lasms.data());
+
+                    expr_ref split(pm);
+                    expr_ref_vector core_cube(pm), core_asms(pm);
+                    unsigned num_conflicts = pctx.m_num_conflicts;
+                    // only an exhausted conflict budget is a reason to split the cube, 
+                    // other unknowns are reported as is.
+                    bool budget_reached = r == l_undef && num_conflicts >= budget && pm.inc();
+                    if (budget_reached) {
+                        // the cube is internalized so that lookahead selects a literal
+                        // under the cube, and a false split refutes the cube.
+                        pctx.push();
+                        for (expr* e : cube)
+                            pctx.assert_expr(e);
+                        pctx.internalize_assertions();
+                        pctx.propagate();
+                        if (pctx.inconsistent())
+                            split = pm.mk_false();
+                        else {
+                            lookahead lh(pctx);
+                            split = lh.choose();
+                        }
+                        pctx.pop(1);
+                        expr* a = nullptr;
+                        if (split && any_of(cube, [&](expr* e) { return e == split || (pm.is_not(e, a) && a == split); }))
+                            split = nullptr;
+                    }
+                    else if (r == l_false) {
+                        for (expr* e : pctx.unsat_core())
+                            (cube.contains(e) ? core_cube : core_asms).push_back(e);
+                        if (!core_cube.empty())
+                            pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
+                    }
+
+                    std::lock_guard<std::mutex> lock(mux);
+                    --num_busy;
+                    cv.notify_all();
+                    if (done)
+                        return;
+                    if (r == l_true || (r == l_false && core_cube.empty())) {
+                        finish(i, r);
+                        return;
+                    }
+                    num_cube_conflicts += num_conflicts;
+                    if ((r == l_undef && !budget_reached) || num_cube_conflicts >= max_conflicts) {
+                        finish(i, l_undef);
+                        return;
+                    }
+                    ast_translation tr(pm, m);
+                    if (r == l_false) {
+                        ++num_refuted;
+                        lemmas.push_back(tr(mk_not(mk_and(pctx.unsat_core())).get()));
+                        lemma_owner.push_back(i);
+                        for (expr* e : core_asms) {
+                            expr* a = tr(e);
+                            if (!asms_core_set.contains(a)) {
+                                asms_core_set.insert(a);
+                                asms_core.push_back(a);
+                            }
+                        }
+                        expr_ref_vector ccube(m);
+                        for (expr* e : core_cube)
+                            ccube.push_back(tr(e));
+                        prune(ccube);
+                    }
+                    else if (pm.is_false(split)) {
+                        // lookahead refuted the cube
+                        ++num_refuted;
+                    }
+                    else if (!split || pm.is_true(split)) {
+                        // no split is available, retry with a larger budget
+                        work[i].push_back(idx);
+                        cube_budget[idx] *= 2;
+                    }
+                    else {
+                        expr_ref lit(tr(split.get()), m), nlit(m.mk_not(lit), m);
+                        for (expr* l : { nlit.get(), lit.get() }) {
+                            expr_ref_vector c(cubes[idx]);
+                            c.push_back(l);
+                            work[i].push_back(cubes.size());
+                            cubes.push_back(c);
+                            cube_budget.push_back(cube_budget[idx]);
+                            ++num_cubes;
+                        }
+                    }
+                    cv.notify_all();
+                }
+            }
+            catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (finished_id == UINT_MAX) {
+                    error_code = err.error_code();
+                    ex_kind = ERROR_EX;
+                    cancel_others(i);
+                }
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (finished_id == UINT_MAX) {
+                    ex_msg = ex.msg();
+                    ex_kind = DEFAULT_EX;
+                    cancel_others(i);
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (finished_id == UINT_MAX) {
+                    ex_msg = "unknown exception";
+                    ex_kind = ERROR_EX;
+                    cancel_others(i);
+                }
+            }
+        };
+
         // for debugging:  num_threads = 1;
 
-        while (true) {
+        if (ctx.get_fparams().m_threads_cube_and_conquer) {
+            vector<std::thread> threads(num_threads);
+            for (unsigned i = 0; i < num_threads; ++i) {
+                threads[i] = std::thread([&, i]() { cube_worker(i); });
+            }
+            for (auto & th : threads) {
+                th.join();
+            }
+            IF_VERBOSE(1, verbose_stream() << "(smt.cube-and-conquer :cubes " << num_cubes << " :refuted " << num_refuted << " :pruned " << num_pruned << ")\n");
+        }
+        else while (true) {
             vector<std::thread> threads(num_threads);
             for (unsigned i = 0; i < num_threads; ++i) {
                 threads[i] = std::thread([&, i]() { worker_thread(i); });
@@ -225,16 +615,31 @@ namespace smt {
             if (done) break;
 
             collect_units();
+            share_clauses();
             ++num_rounds;
             max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
             thread_max_conflicts *= 2;            
         }
 
-        for (context* c : pctxs) {
+        // worker statistics are cumulative across checks.
+        ctx.m_aux_stats.reset();
+        for (context* c : m_pctxs) {
             c->collect_statistics(ctx.m_aux_stats);
         }
+        if (ctx.get_fparams().m_threads_cube_and_conquer) {
+            ctx.m_aux_stats.update("parallel cubes", num_cubes);
+            ctx.m_aux_stats.update("parallel cubes refuted", num_refuted);
+            ctx.m_aux_stats.update("parallel cubes pruned", num_pruned);
+        }
+        for (ast_manager* pm : m_pms) {
+            pm->limit().reset_cancel();
+        }
+        // workers are reused by the next check, undo the per-round conflict budgets.
+        for (smt_params* p : m_params) 
+            p->m_max_conflicts = user_max_conflicts;
 
         if (finished_id == UINT_MAX) {
+            reset_workers();
             switch (ex_kind) {
             case ERROR_EX: throw z3_error(error_code);
             default: throw default_exception(std::move(ex_msg));
@@ -242,8 +647,8 @@ namespace smt {
         }        
 
         model_ref mdl;        
-        context& pctx = *pctxs[finished_id];
-        ast_translation tr(*pms[finished_id], m);
+        context& pctx = *m_pctxs[finished_id];
+        ast_translation tr(*m_pms[finished_id], m);
         switch (result) {
         case l_true: 
             pctx.get_model(mdl);
@@ -252,6 +657,11 @@ namespace smt {
             break;
         case l_false:
             ctx.m_unsat_core.reset();
+            if (exhausted) {
+                // every cube was refuted using assumptions from asms_core.
+                ctx.m_unsat_core.append(asms_core);
+                break;
+            }
             for (expr* e : pctx.unsat_core()) 
                 ctx.m_unsat_core.push_back(tr(e));
             break;
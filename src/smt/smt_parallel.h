@@ -18,17 +18,47 @@ Revision History:
 --*/
 #pragma once
 
+#include "util/scoped_ptr_vector.h"
 #include "smt/smt_context.h"
 
 namespace smt {
 
     class parallel {
         context& ctx;
+
+        // worker contexts are kept across checks and follow the user scopes of ctx.
+        scoped_ptr_vector<smt_params>  m_params;
+        scoped_ptr_vector<ast_manager> m_pms;
+        scoped_ptr_vector<context>     m_pctxs;
+        unsigned                       m_num_formulas = 0;  // number of formulas of ctx copied to workers
+        unsigned_vector                m_num_formulas_lim;  // m_num_formulas at each user scope of the workers
+        unsigned                       m_num_macros = 0;    // number of macros of ctx copied to workers
+        unsigned_vector                m_num_macros_lim;
+
+        // units and learned clauses of the workers, shared across checks and trimmed on pop.
+        obj_hashtable<expr>            m_unit_set;
+        expr_ref_vector                m_unit_trail;
+        unsigned_vector                m_unit_trail_lim;
+        unsigned_vector                m_unit_qhead;        // units of m_unit_trail asserted to each worker
+        unsigned_vector                m_assigned_qhead;    // base level literals collected from each worker
+        obj_hashtable<expr>            m_clause_set;
+        expr_ref_vector                m_clause_trail;
+        unsigned_vector                m_clause_trail_lim;
+        unsigned_vector                m_clause_owner;
+        unsigned                       m_clause_qhead = 0;  // clauses of m_clause_trail asserted to the workers
+        unsigned_vector                m_lemma_qhead;       // lemmas collected from each worker
+
+        void init_workers(unsigned num_threads);
+        void sync_workers();
+        void reset_workers();
+
     public:
-        parallel(context& ctx): ctx(ctx) {}
+        parallel(context& ctx): ctx(ctx), m_unit_trail(ctx.get_manager()), m_clause_trail(ctx.get_manager()) {}
 
         lbool operator()(expr_ref_vector const& asms);
 
+        void push();
+        void pop(unsigned num_scopes);
     };
 
 }
@@ -21,6 +21,7 @@ Revision History:
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt2_pp.h"
+#include "util/bit_vector.h"
 
 namespace smt {
 
@@ -127,8 +128,13 @@ namespace smt {
         expr_ref_vector                m_relevant_exprs; 
         uint_set                       m_is_relevant;
         typedef list<relevancy_eh *>   relevancy_ehs;
-        obj_map<expr, relevancy_ehs *> m_relevant_ehs;
-        obj_map<expr, relevancy_ehs *> m_watches[2];
+        // handlers and watches are indexed by expression id.
+        ptr_vector<relevancy_ehs>      m_relevant_ehs;
+        ptr_vector<relevancy_ehs>      m_watches[2];
+        // m_justified contains the assigned or/and-applications whose relevancy was already
+        // propagated to their arguments, i.e., they do not need to be visited again until backtracking.
+        bit_vector                     m_justified;
+        unsigned_vector                m_justified_trail;
         struct eh_trail {
             enum class kind { POS_WATCH, NEG_WATCH, HANDLER };
             kind   m_kind;
@@ -142,6 +148,7 @@ namespace smt {
         struct scope {
             unsigned m_relevant_exprs_lim;
             unsigned m_trail_lim;
+            unsigned m_justified_lim;
         };
         svector<scope>                 m_scopes;
         bool                           m_propagating = false;
@@ -158,32 +165,52 @@ namespace smt {
             }
         }
 
+        static relevancy_ehs * get_ehs(ptr_vector<relevancy_ehs> const & v, expr * n) {
+            unsigned id = n->get_id();
+            return id < v.size() ? v[id] : nullptr;
+        }
+
+        static void set_ehs(ptr_vector<relevancy_ehs> & v, expr * n, relevancy_ehs * ehs) {
+            unsigned id = n->get_id();
+            if (ehs == nullptr && id >= v.size())
+                return;
+            v.reserve(id + 1, nullptr);
+            v[id] = ehs;
+        }
+
         relevancy_ehs * get_handlers(expr * n) {
-            relevancy_ehs * r = nullptr;
-            m_relevant_ehs.find(n, r);
-            SASSERT(m_relevant_ehs.contains(n) || r == 0);
-            return r;
+            return get_ehs(m_relevant_ehs, n);
         }
 
         void set_handlers(expr * n, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_relevant_ehs.erase(n);
-            else
-                m_relevant_ehs.insert(n, ehs);
+            set_ehs(m_relevant_ehs, n, ehs);
         }
 
         relevancy_ehs * get_watches(expr * n, bool val) {
-            relevancy_ehs * r = nullptr;
-            m_watches[val ? 1 : 0].find(n, r);
-            SASSERT(m_watches[val ? 1 : 0].contains(n) || r == 0);
-            return r;
+            return get_ehs(m_watches[val ? 1 : 0], n);
         }
 
         void set_watches(expr * n, bool val, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_watches[val ? 1 : 0].erase(n);
-            else
-                m_watches[val ? 1 : 0].insert(n, ehs);
+            set_ehs(m_watches[val ? 1 : 0], n, ehs);
+        }
+
+        bool is_justified(app * n) const {
+            return n->get_id() < m_justified.size() && m_justified.get(n->get_id());
+        }
+
+        void set_justified(app * n) {
+            unsigned id = n->get_id();
+            m_justified.reserve(id + 1, false);
+            if (m_justified.get(id))
+                return;
+            m_justified.set(id);
+            m_justified_trail.push_back(id);
+        }
+
+        void undo_justified(unsigned old_lim) {
+            for (unsigned i = old_lim; i < m_justified_trail.size(); ++i)
+                m_justified.unset(m_justified_trail[i]);
+            m_justified_trail.shrink(old_lim);
         }
 
         void push_trail(eh_trail const & t) {
@@ -253,6 +280,7 @@ namespace smt {
             scope & s                  = m_scopes.back();
             s.m_relevant_exprs_lim     = m_relevant_exprs.size();
             s.m_trail_lim              = m_trail.size();
+            s.m_justified_lim          = m_justified_trail.size();
         }
 
         void pop(unsigned num_scopes) override {
@@ -263,6 +291,7 @@ namespace smt {
             scope & s        = m_scopes[new_lvl];
             unmark_relevant_exprs(s.m_relevant_exprs_lim);
             undo_trail(s.m_trail_lim);
+            undo_justified(s.m_justified_lim);
             m_scopes.shrink(new_lvl);
         }
 
@@ -364,8 +393,10 @@ namespace smt {
         */
         void propagate_relevant_or(app * n) {
             SASSERT(get_manager().is_or(n));
-            
-            lbool val    = m_context.find_assignment(n);
+            if (is_justified(n))
+                return;
+            lbool val     = m_context.find_assignment(n);
+            bool assigned = val != l_undef;
             // If val is l_undef, then the expression
             // is a root, and no boolean variable was created for it.
             if (val == l_undef)
@@ -373,6 +404,7 @@ namespace smt {
             switch (val) {
             case l_false:
                 propagate_relevant_app(n);
+                set_justified(n);
                 break;
             case l_undef:
                 break;
@@ -380,14 +412,20 @@ namespace smt {
                 expr * true_arg = nullptr;
                 for (expr* arg : *n) {
                     if (m_context.find_assignment(arg) == l_true) {
-                        if (is_relevant_core(arg))
-                            return;
+                        if (is_relevant_core(arg)) {
+                            true_arg = arg;
+                            break;
+                        }
                         else if (!true_arg)
                             true_arg = arg;
                     }
                 }
-                if (true_arg)
-                    mark_as_relevant(true_arg);
+                if (!true_arg)
+                    break;
+                mark_as_relevant(true_arg);
+                // the or-application of an unassigned root may still be assigned.
+                if (assigned)
+                    set_justified(n);
                 break;
             } }
         }
@@ -396,26 +434,33 @@ namespace smt {
            \brief Propagate relevancy for an and-application.
         */
         void propagate_relevant_and(app * n) {
+            if (is_justified(n))
+                return;
             lbool val    = m_context.find_assignment(n);
             switch (val) {
             case l_false: {
                 expr * false_arg = nullptr;
                 for (expr* arg : *n) {
                     if (m_context.find_assignment(arg) == l_false) {
-                        if (is_relevant_core(arg))
-                            return; 
+                        if (is_relevant_core(arg)) {
+                            false_arg = arg;
+                            break;
+                        }
                         else if (!false_arg)
                             false_arg = arg;
                     }
                 }
-                if (false_arg)
+                if (false_arg) {
                     mark_as_relevant(false_arg);
+                    set_justified(n);
+                }
                 break;
             }
             case l_undef:
                 break;
             case l_true:
                 propagate_relevant_app(n);
+                set_justified(n);
                 break;
             }
         }
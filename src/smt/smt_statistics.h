@@ -39,6 +39,7 @@ namespace smt {
         unsigned m_num_mk_lits;
         unsigned m_num_dyn_ack;
         unsigned m_num_del_dyn_ack;
+        unsigned m_num_cached_dyn_ack;
         unsigned m_num_interface_eqs;
         unsigned m_max_generation;
         unsigned m_num_minimized_lits;
@@ -34,6 +34,7 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 
 #include "math/lp/cross_nested.h"
@@ -559,6 +560,8 @@ void setup_args_parser(argument_parser &parser) {
                                        "test rationals using plus instead of +=");
     parser.add_option_with_help_string("--maximize_term", "test maximize_term()");
     parser.add_option_with_help_string("--patching", "test patching");
+    parser.add_option_with_help_string("--float_simplex", "test the double precision simplex");
+    parser.add_option_with_help_string("--row_activity", "test the cached row activities of bound propagation");
 }
 
 struct fff {
@@ -1646,6 +1649,169 @@ void test_maximize_term() {
         std::cout << "v[" << p.first << "] = " << p.second << std::endl;
     }
 }
+// Solve a random system, feasible by construction unless infeasible is set,
+// and return the status. The double precision simplex runs when float_simplex is set,
+// float_bases counts the bases it found.
+lp_status solve_random_system(unsigned seed, bool float_simplex, bool infeasible, unsigned &float_bases) {
+    lar_solver solver;
+    solver.settings().set_float_simplex(float_simplex);
+    solver.settings().float_simplex_min_infeasible = 1;
+    random_gen rand(seed);
+    unsigned num_vars = 12, num_terms = 24;
+    vector<lpvar> vars;
+    vector<int> point;
+    vector<std::tuple<vector<std::pair<mpq, lpvar>>, int, int>> rows;
+    for (unsigned j = 0; j < num_vars; j++) {
+        vars.push_back(solver.add_var(j, false));
+        point.push_back(static_cast<int>(rand(21)) - 10);
+        solver.add_var_bound(vars[j], GE, mpq(-20));
+        solver.add_var_bound(vars[j], LE, mpq(20));
+    }
+    for (unsigned i = 0; i < num_terms; i++) {
+        vector<std::pair<mpq, lpvar>> coeffs;
+        int val = 0;
+        for (unsigned j = 0; j < num_vars; j++) {
+            int a = static_cast<int>(rand(11)) - 5;
+            if (a == 0 || rand(3) != 0)
+                continue;
+            coeffs.push_back(std::make_pair(mpq(a), vars[j]));
+            val += a * point[j];
+        }
+        if (coeffs.empty())
+            continue;
+        lpvar t = solver.add_term(coeffs, null_lpvar);
+        int slack = static_cast<int>(rand(3));
+        solver.add_var_bound(t, GE, mpq(val - slack));
+        solver.add_var_bound(t, LE, mpq(val + slack));
+        rows.push_back(std::make_tuple(coeffs, val - slack, val + slack));
+    }
+    if (infeasible) {
+        // x0 + x1 <= v - 1 and 2*x0 + 2*x1 >= 2*v
+        vector<std::pair<mpq, lpvar>> coeffs;
+        coeffs.push_back(std::make_pair(mpq(1), vars[0]));
+        coeffs.push_back(std::make_pair(mpq(1), vars[1]));
+        lpvar t = solver.add_term(coeffs, null_lpvar);
+        solver.add_var_bound(t, LE, mpq(point[0] + point[1] - 1));
+        coeffs.reset();
+        coeffs.push_back(std::make_pair(mpq(2), vars[0]));
+        coeffs.push_back(std::make_pair(mpq(2), vars[1]));
+        t = solver.add_term(coeffs, null_lpvar);
+        solver.add_var_bound(t, GE, mpq(2 * (point[0] + point[1])));
+    }
+    lp_status st = solver.find_feasible_solution();
+    if (st != lp_status::INFEASIBLE) {
+        std::unordered_map<lpvar, mpq> model;
+        solver.get_model(model);
+        for (auto const &r : rows) {
+            mpq val(0);
+            for (auto const &c : std::get<0>(r))
+                val += c.first * model[c.second];
+            VERIFY(mpq(std::get<1>(r)) <= val && val <= mpq(std::get<2>(r)));
+        }
+    }
+    float_bases += solver.settings().stats().m_float_simplex_bases;
+    return st;
+}
+
+void test_float_simplex() {
+    std::cout << "test_float_simplex\n";
+    unsigned float_bases = 0, exact_bases = 0;
+    for (unsigned seed = 0; seed < 100; seed++) {
+        for (bool infeasible : { false, true }) {
+            lp_status st = solve_random_system(seed, false, infeasible, exact_bases);
+            lp_status fst = solve_random_system(seed, true, infeasible, float_bases);
+            VERIFY(st == fst);
+            VERIFY(infeasible == (st == lp_status::INFEASIBLE));
+        }
+    }
+    VERIFY(exact_bases == 0);
+    // the candidate bases found in doubles were installed in the exact tableau
+    VERIFY(float_bases > 0);
+    std::cout << "float simplex bases " << float_bases << std::endl;
+}
+
+struct row_activity_imp {
+    lar_solver &m_solver;
+    row_activity_imp(lar_solver &s) : m_solver(s) {}
+    lar_solver &lp() { return m_solver; }
+    const lar_solver &lp() const { return m_solver; }
+    bool bound_is_interesting(unsigned, lconstraint_kind, const rational &) const { return true; }
+    void consume(const rational &, constraint_index) {}
+};
+
+// The bounds implied by the rows with the cached activities are the same as
+// the bounds implied by scanning the rows, after the bounds are changed,
+// the tableau is pivoted, and the scopes are popped.
+void check_row_activities(lar_solver &solver) {
+    typedef lp_bound_propagator<row_activity_imp> propagator;
+    typedef bound_analyzer_on_row<row_strip<mpq>, propagator> analyzer;
+    row_activity_imp imp(solver);
+    for (unsigned i = 0; i < solver.A_r().row_count(); i++) {
+        std_vector<implied_bound> ibounds, cached_ibounds;
+        propagator bp(imp, ibounds), cached_bp(imp, cached_ibounds);
+        bp.init();
+        cached_bp.init();
+        const row_activity &act = solver.get_row_activity(i);
+        unsigned n = analyzer::analyze_row(solver.get_row(i), null_ci, zero_of_type<numeric_pair<mpq>>(), i, bp);
+        unsigned cached_n = analyzer::analyze_row(solver.get_row(i), act, i, cached_bp);
+        VERIFY(n == cached_n);
+        VERIFY(ibounds.size() == cached_ibounds.size());
+        for (unsigned k = 0; k < ibounds.size(); k++) {
+            auto const &b = ibounds[k], &cb = cached_ibounds[k];
+            VERIFY(b.m_j == cb.m_j && b.m_bound == cb.m_bound);
+            VERIFY(b.m_is_lower_bound == cb.m_is_lower_bound && b.m_strict == cb.m_strict);
+        }
+    }
+    VERIFY(solver.row_activities_are_correct());
+}
+
+void test_row_activity() {
+    std::cout << "test_row_activity\n";
+    lconstraint_kind kinds[] = { LE, LT, GE, GT, EQ };
+    for (unsigned seed = 0; seed < 50; seed++) {
+        lar_solver solver;
+        random_gen rand(seed);
+        unsigned num_vars = 8, num_scopes = 0, ext = 0;
+        vector<lpvar> columns;
+        for (unsigned j = 0; j < num_vars; j++)
+            columns.push_back(solver.add_var(ext++, false));
+        auto add_term = [&]() {
+            vector<std::pair<mpq, lpvar>> coeffs;
+            for (unsigned j = 0; j < num_vars; j++)
+                if (rand(3) == 0)
+                    coeffs.push_back(std::make_pair(mpq(static_cast<int>(rand(7)) - 3, static_cast<int>(rand(2)) + 1), columns[j]));
+            if (!coeffs.empty())
+                solver.add_term(coeffs, ext++);
+        };
+        for (unsigned i = 0; i < 6; i++)
+            add_term();
+        for (unsigned round = 0; round < 40; round++) {
+            switch (rand(6)) {
+            case 0:
+                solver.push();
+                num_scopes++;
+                break;
+            case 1:
+                if (num_scopes > 0) {
+                    solver.pop(1);
+                    num_scopes--;
+                }
+                break;
+            case 2:
+                add_term();
+                break;
+            default: {
+                lpvar j = rand(solver.column_count());
+                solver.add_var_bound(j, kinds[rand(5)], mpq(static_cast<int>(rand(21)) - 10));
+                break;
+            }
+            }
+            solver.find_feasible_solution();
+            check_row_activities(solver);
+        }
+    }
+}
+
 #ifdef Z3DEBUG
 void test_hnf() {
     test_larger_generated_hnf();
@@ -1795,6 +1961,14 @@ void test_lp_local(int argn, char **argv) {
         test_bound_propagation();
         return finalize(0);
     }
+    if (args_parser.option_is_used("--float_simplex")) {
+        test_float_simplex();
+        return finalize(0);
+    }
+    if (args_parser.option_is_used("--row_activity")) {
+        test_row_activity();
+        return finalize(0);
+    }
 
     return finalize(0);  // has_violations() ? 1 : 0);
 }
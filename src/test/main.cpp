@@ -196,6 +196,7 @@ int main(int argc, char ** argv) {
     TST(escaped);
     TST(buffer);
     TST(chashtable);
+    TST(oa_hashtable);
     TST(egraph);
     TST(ex);
     TST(nlarith_util);
@@ -243,6 +244,7 @@ int main(int argc, char ** argv) {
     TST(rcf);
     TST(polynorm);
     TST(qe_arith);
+    TST(qi_queue);
     TST(expr_substitution);
     TST(sorting_network);
     TST(theory_pb);
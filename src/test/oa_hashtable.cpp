@@ -0,0 +1,109 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    oa_hashtable.cpp
+
+Abstract:
+
+    Hashtable with open addressing.
+
+--*/
+#include "util/oa_hashtable.h"
+#include "util/hashtable.h"
+#include "util/hash.h"
+#include "util/util.h"
+#include <iostream>
+
+typedef oa_hashtable<int, int_hash, default_eq<int> > int_table;
+
+template class oa_hashtable<int, int_hash, default_eq<int> >;
+
+struct oa_dummy_hash {
+    unsigned operator()(int v) const { return v % 3; }
+};
+
+typedef oa_hashtable<int, oa_dummy_hash, default_eq<int> > dint_table;
+
+template class oa_hashtable<int, oa_dummy_hash, default_eq<int> >;
+
+static void tst1() {
+    int_table t;
+    ENSURE(t.empty());
+    t.insert(10);
+    t.insert(20);
+    t.insert(30);
+    ENSURE(t.insert_if_not_there(20) == 20);
+    ENSURE(t.size() == 3);
+    ENSURE(t.contains(10) && t.contains(20) && t.contains(30));
+    t.erase(20);
+    ENSURE(!t.contains(20));
+    ENSURE(t.size() == 2);
+    int r = 0;
+    ENSURE(t.find(30, r) && r == 30);
+    t.reset();
+    ENSURE(t.empty() && !t.contains(10));
+}
+
+// all values collide, so the probe sequences cross full blocks and erased slots.
+static void tst2() {
+    dint_table t;
+    for (int i = 0; i < 100; ++i)
+        t.insert(3 * i);
+    ENSURE(t.size() == 100);
+    for (int i = 0; i < 100; i += 2)
+        t.erase(3 * i);
+    ENSURE(t.size() == 50);
+    for (int i = 0; i < 100; ++i)
+        ENSURE(t.contains(3 * i) == (i % 2 == 1));
+    for (int i = 0; i < 100; i += 2)
+        t.insert(3 * i);
+    for (int i = 0; i < 100; ++i)
+        ENSURE(t.contains(3 * i));
+    unsigned n = 0;
+    for (int v : t) {
+        ENSURE(v % 3 == 0);
+        ++n;
+    }
+    ENSURE(n == 100);
+    // lookup with an equality that is coarser than the equality of the table.
+    int r = 1;
+    ENSURE(!t.contains(300));
+    ENSURE(t.find(300, r, [](int a, int b) { return a % 3 == b % 3; }) && r % 3 == 0);
+    ENSURE(!t.find(301, r, [](int a, int b) { return a % 3 == b % 3; }));
+}
+
+typedef int_hashtable<int_hash, default_eq<int> > int_set;
+
+template<typename T>
+static void tst3(unsigned num, unsigned N) {
+    int_set s;
+    T       t;
+    for (unsigned i = 0; i < num; i++) {
+        int v = rand() % N;
+        if (rand() % 3 == 2) {
+            s.erase(v);
+            t.erase(v);
+            ENSURE(!t.contains(v));
+        }
+        else {
+            s.insert(v);
+            t.insert(v);
+            ENSURE(t.contains(v));
+        }
+        ENSURE(s.size() == t.size());
+    }
+    for (int v : s)
+        ENSURE(t.contains(v));
+    for (int v : t)
+        ENSURE(s.contains(v));
+}
+
+void tst_oa_hashtable() {
+    tst1();
+    tst2();
+    tst3<dint_table>(1000, 10);
+    tst3<dint_table>(10000, 100);
+    tst3<int_table>(50000, 1000);
+}
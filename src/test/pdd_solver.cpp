@@ -80,6 +80,55 @@ namespace dd {
         // 
     }
 
+    bool has_conflict(solver& gb) {
+        for (solver::equation* e : gb.equations())
+            if (e->poly().is_val() && !e->poly().is_zero())
+                return true;
+        return false;
+    }
+
+    bool has_equation(solver& gb, pdd const& p) {
+        for (solver::equation* e : gb.equations())
+            if (e->poly() == p || e->poly() == -p)
+                return true;
+        return false;
+    }
+
+    void test_parallel() {
+        pdd_manager m(4);
+        u_dependency_manager dm;
+        reslimit lim;
+        pdd v1 = m.mk_var(1);
+        pdd v2 = m.mk_var(2);
+        pdd v3 = m.mk_var(3);
+
+        solver gb(lim, dm, m);
+        solver::config cfg;
+        cfg.m_threads = 2;
+        gb.set(cfg);
+
+        gb.add(v1*v3*v3 + v3*v1 + 2, dm.mk_leaf(0));
+        gb.add(v1*v3*v3 + v3*v1, dm.mk_leaf(1));
+        gb.add(v3*v1 + v1*v2 + v2*v3, dm.mk_leaf(2));
+        gb.add(v3*v1 + v1*v2 + v2*v3 + v1, dm.mk_leaf(3));
+        gb.add(v3*v1 + v1*v2 + v2*v3 + v2, dm.mk_leaf(4));
+        gb.saturate();
+        gb.display(std::cout << "parallel early contradiction\n");
+        VERIFY(has_conflict(gb));
+        gb.reset();
+
+        gb.add(v1*v3*v3 + v3*v1, dm.mk_leaf(1));
+        gb.add(v3*v1 + v1*v2 + v2*v3, dm.mk_leaf(2));
+        gb.add(v3*v1 + v1*v2 + v2*v3 + v1, dm.mk_leaf(3));
+        gb.add(v3*v1 + v1*v2 + v2*v3 + v2, dm.mk_leaf(4));
+        gb.saturate();
+        gb.display(std::cout << "parallel v1 = v2 = 0\n");
+        VERIFY(!has_conflict(gb));
+        VERIFY(has_equation(gb, v1));
+        VERIFY(has_equation(gb, v2));
+        gb.reset();
+    }
+
     expr_ref elim_or(ast_manager& m, expr* e) {
         obj_map<expr, expr*> cache;
         expr_ref_vector trail(m), todo(m), args(m);
@@ -261,4 +310,5 @@ namespace dd {
 void tst_pdd_solver() {
     dd::test1();
     dd::test2();
+    dd::test_parallel();
 }
@@ -0,0 +1,67 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "smt/params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "parsers/smt2/smt2parser.h"
+#include "cmd_context/cmd_context.h"
+#include "util/statistics.h"
+#include <sstream>
+#include <iostream>
+
+// a matching loop: every instance creates a term that matches the pattern again.
+static char const* s_matching_loop =
+    "(declare-sort U 0)\n"
+    "(declare-fun f (U) U)\n"
+    "(declare-fun P (U) Bool)\n"
+    "(declare-const a U)\n"
+    "(assert (forall ((x U)) (! (P (f x)) :pattern ((P x)))))\n"
+    "(assert (P a))\n";
+
+static unsigned get_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static void check_matching_loop(unsigned loop_limit, unsigned& num_instances, unsigned& num_throttled) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::istringstream is(s_matching_loop);
+    VERIFY(parse_smt2_commands(ctx, is));
+    smt_params fp;
+    fp.m_qi_loop_limit = loop_limit;
+    fp.m_mbqi = false;
+    // a throttle that instantiates the loop stops at this limit instead of diverging.
+    fp.m_qi_max_instances = 1000;
+    smt::kernel solver(m, fp);
+    for (expr* e : ctx.assertions())
+        solver.assert_expr(e);
+    lbool r = solver.check();
+    statistics st;
+    solver.collect_statistics(st);
+    num_instances = get_stat(st, "quant instantiations");
+    num_throttled = get_stat(st, "throttled quant instantiations");
+    std::cout << "loop limit " << loop_limit << ": " << r << " instances " << num_instances << " throttled " << num_throttled << "\n";
+    ENSURE(r != l_false);
+}
+
+void tst_qi_queue() {
+    unsigned num_instances = 0, num_throttled = 0;
+    check_matching_loop(0, num_instances, num_throttled);
+    ENSURE(num_instances > 0 && num_throttled == 0);
+    unsigned max_instances = num_instances;
+    // throttled instances are only instantiated lazily when they are below the lazy threshold,
+    // so the throttle never adds instances.
+    for (unsigned limit : { 1u, 3u, 5u }) {
+        check_matching_loop(limit, num_instances, num_throttled);
+        ENSURE(num_throttled > 0);
+        ENSURE(num_instances <= max_instances);
+    }
+}
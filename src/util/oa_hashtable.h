@@ -0,0 +1,285 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    oa_hashtable.h
+
+Abstract:
+
+    Hashtable with open addressing for trivially copyable values such
+    as pointers. It has the same interface as chashtable.
+
+    Slots are grouped in blocks of 16. Each slot has a one byte tag that
+    is either empty, deleted or the top 7 bits of the hash of the value
+    in the slot. The hash of each value is stored next to it. A lookup
+    compares the tags of a block at once (using SSE2 when available) and
+    only invokes the equality predicate on values with the same hash.
+    The hashes are not recomputed when the table grows.
+
+    A value is placed in the first block with a free slot starting at the
+    block given by its hash, and a lookup stops at the first block
+    with an empty slot. So, an erased slot can be marked empty if its
+    block has another empty slot.
+
+    As in chashtable, the hash of a value must not change while the value
+    is in the table.
+
+--*/
+#pragma once
+
+#include <climits>
+#include <cstring>
+#include <type_traits>
+#include "util/memory_manager.h"
+#include "util/debug.h"
+#include "util/bit_util.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OA_HASHTABLE_SSE2
+#endif
+
+template<typename T, typename HashProc, typename EqProc>
+class oa_hashtable : private HashProc, private EqProc {
+    static_assert(std::is_trivially_copyable<T>::value, "oa_hashtable values must be trivially copyable");
+
+    static const unsigned      block_size  = 16;
+    static const unsigned char empty_tag   = 0;
+    static const unsigned char deleted_tag = 1;
+
+    struct slot {
+        unsigned m_hash;
+        T        m_data;
+    };
+
+    unsigned char * m_tags     = nullptr;
+    slot *          m_slots    = nullptr;
+    unsigned        m_capacity = 0;  // zero or a power of two multiple of block_size.
+    unsigned        m_size     = 0;
+    unsigned        m_deleted  = 0;
+
+    static unsigned char mk_tag(unsigned h) { return static_cast<unsigned char>(0x80 | (h >> 25)); }
+    static bool is_used(unsigned char t) { return t >= 0x80; }
+
+    static unsigned first(unsigned bits) {
+#ifdef __GNUC__
+        return __builtin_ctz(bits);
+#else
+        return ntz_core(bits);
+#endif
+    }
+
+    /**
+       \brief Return a bit-mask of the tags in the block that are equal to t.
+    */
+    static unsigned match(unsigned char const * tags, unsigned char t) {
+#ifdef OA_HASHTABLE_SSE2
+        __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(tags));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(t)))));
+#else
+        unsigned r = 0;
+        for (unsigned i = 0; i < block_size; ++i)
+            if (tags[i] == t)
+                r |= (1u << i);
+        return r;
+#endif
+    }
+
+    unsigned get_hash(T const & d) const { return HashProc::operator()(d); }
+
+    unsigned block_mask() const { return m_capacity / block_size - 1; }
+
+    void alloc_table(unsigned capacity) {
+        m_capacity = capacity;
+        m_tags     = static_cast<unsigned char *>(memory::allocate(capacity));
+        m_slots    = static_cast<slot *>(memory::allocate(sizeof(slot) * capacity));
+        memset(m_tags, empty_tag, capacity);
+    }
+
+    void free_table() {
+        if (m_tags) {
+            memory::deallocate(m_tags);
+            memory::deallocate(m_slots);
+        }
+        m_tags     = nullptr;
+        m_slots    = nullptr;
+        m_capacity = 0;
+    }
+
+    /**
+       \brief Return the position of a free slot for a value with hash h.
+    */
+    unsigned find_free(unsigned h) const {
+        unsigned mask = block_mask();
+        for (unsigned b = h & mask; ; b = (b + 1) & mask) {
+            unsigned char const * tags = m_tags + b * block_size;
+            unsigned bits = match(tags, empty_tag) | match(tags, deleted_tag);
+            if (bits)
+                return b * block_size + first(bits);
+        }
+    }
+
+    unsigned find_pos(T const & d, unsigned h) const {
+        return find_pos(d, h, static_cast<EqProc const &>(*this));
+    }
+
+    /**
+       \brief Return the position of a value equal to d modulo eq, or UINT_MAX if there is none.
+    */
+    template<typename Eq>
+    unsigned find_pos(T const & d, unsigned h, Eq const & eq) const {
+        if (m_capacity == 0)
+            return UINT_MAX;
+        unsigned mask      = block_mask();
+        unsigned char tag  = mk_tag(h);
+        for (unsigned b = h & mask; ; b = (b + 1) & mask) {
+            unsigned char const * tags = m_tags + b * block_size;
+            slot const * slots = m_slots + b * block_size;
+            for (unsigned bits = match(tags, tag); bits; bits &= bits - 1) {
+                unsigned i = first(bits);
+                if (slots[i].m_hash == h && eq(slots[i].m_data, d))
+                    return b * block_size + i;
+            }
+            if (match(tags, empty_tag))
+                return UINT_MAX;
+        }
+    }
+
+    void rehash(unsigned new_capacity) {
+        unsigned char * old_tags  = m_tags;
+        slot *          old_slots = m_slots;
+        unsigned        old_cap   = m_capacity;
+        alloc_table(new_capacity);
+        m_deleted = 0;
+        for (unsigned i = 0; i < old_cap; ++i) {
+            if (!is_used(old_tags[i]))
+                continue;
+            unsigned p = find_free(old_slots[i].m_hash);
+            m_tags[p]  = old_tags[i];
+            m_slots[p] = old_slots[i];
+        }
+        if (old_tags) {
+            memory::deallocate(old_tags);
+            memory::deallocate(old_slots);
+        }
+    }
+
+    /**
+       \brief Make sure there is room for one more value and that every
+       probe sequence ends in a block with an empty slot.
+    */
+    void reserve_one() {
+        if (m_capacity == 0)
+            alloc_table(block_size);
+        else if ((m_size + m_deleted + 1) * 8 > m_capacity * 7)
+            // grow if the table is at least half full, otherwise just remove the deleted slots.
+            rehash(2 * m_size >= m_capacity ? 2 * m_capacity : m_capacity);
+    }
+
+public:
+    oa_hashtable(HashProc const & h = HashProc(), EqProc const & e = EqProc()):
+        HashProc(h),
+        EqProc(e) {
+    }
+
+    oa_hashtable(oa_hashtable const &) = delete;
+    oa_hashtable & operator=(oa_hashtable const &) = delete;
+
+    ~oa_hashtable() {
+        free_table();
+    }
+
+    unsigned size() const { return m_size; }
+
+    bool empty() const { return m_size == 0; }
+
+    unsigned capacity() const { return m_capacity; }
+
+    void reset() {
+        free_table();
+        m_size    = 0;
+        m_deleted = 0;
+    }
+
+    /**
+       \brief Insert d if the table does not contain a value equal to d.
+       Return the value in the table.
+    */
+    T insert_if_not_there(T const & d) {
+        unsigned h = get_hash(d);
+        unsigned p = find_pos(d, h);
+        if (p != UINT_MAX)
+            return m_slots[p].m_data;
+        reserve_one();
+        p = find_free(h);
+        if (m_tags[p] == deleted_tag)
+            --m_deleted;
+        m_tags[p]          = mk_tag(h);
+        m_slots[p].m_hash  = h;
+        m_slots[p].m_data  = d;
+        ++m_size;
+        return d;
+    }
+
+    void insert(T const & d) {
+        insert_if_not_there(d);
+    }
+
+    bool find(T const & d, T & r) const {
+        unsigned p = find_pos(d, get_hash(d));
+        if (p == UINT_MAX)
+            return false;
+        r = m_slots[p].m_data;
+        return true;
+    }
+
+    /**
+       \brief Similar to find, but values are compared using eq instead of
+       the equality of the table. eq must be compatible with the hash function.
+    */
+    template<typename Eq>
+    bool find(T const & d, T & r, Eq const & eq) const {
+        unsigned p = find_pos(d, get_hash(d), eq);
+        if (p == UINT_MAX)
+            return false;
+        r = m_slots[p].m_data;
+        return true;
+    }
+
+    bool contains(T const & d) const {
+        return find_pos(d, get_hash(d)) != UINT_MAX;
+    }
+
+    void erase(T const & d) {
+        unsigned p = find_pos(d, get_hash(d));
+        if (p == UINT_MAX)
+            return;
+        --m_size;
+        if (match(m_tags + (p & ~(block_size - 1)), empty_tag))
+            m_tags[p] = empty_tag;
+        else {
+            m_tags[p] = deleted_tag;
+            ++m_deleted;
+        }
+    }
+
+    class iterator {
+        oa_hashtable const * m_table;
+        unsigned             m_pos;
+        void move_to_used() {
+            while (m_pos < m_table->m_capacity && !is_used(m_table->m_tags[m_pos]))
+                ++m_pos;
+        }
+    public:
+        iterator(oa_hashtable const * t, unsigned pos): m_table(t), m_pos(pos) { move_to_used(); }
+        T const & operator*() const { return m_table->m_slots[m_pos].m_data; }
+        T const * operator->() const { return &m_table->m_slots[m_pos].m_data; }
+        iterator & operator++() { ++m_pos; move_to_used(); return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+        bool operator==(iterator const & it) const { return m_pos == it.m_pos; }
+        bool operator!=(iterator const & it) const { return m_pos != it.m_pos; }
+    };
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, m_capacity); }
+};